@@ -0,0 +1,274 @@
+// ============================================================================
+//  Roulette Benchmarks.cpp - throughput benchmarks for the simulator's hot
+//  paths: single spins and batch draws per generator, kernel steps, stats
+//  recording, spin-log replay and whole batches at 1..N threads, with heap
+//  bytes per item.
+//  Usage: "Roulette Benchmarks" [--filter text] [--min-time seconds] [--threads N]
+//  Build:  C++20, Visual Studio 2022 (x64, Windows)
+// ============================================================================
+
+// ----- Standard C++ headers -------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ----- Project headers ------------------------------------------------------
+#include "CpuDispatch.h"
+#include "RouletteCore.h"
+#include "SimulationEngine.h"
+#include "SpinLog.h"
+#include "StatsTracker.h"
+#include "StrategyKernel.h"
+#include "StrategyProgram.h"
+
+// ----------------------------------------------------------------------------
+//  Allocation counting - every heap allocation in the process goes through
+//  these, so a benchmark can report heap bytes per item it processed
+// ----------------------------------------------------------------------------
+static std::atomic<std::uint64_t> allocatedBytes{ 0 };
+
+void* operator new(std::size_t n) {
+    allocatedBytes.fetch_add(n, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t n) { return ::operator new(n); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+static volatile std::uint64_t sink = 0; // keeps benchmark results observable
+
+// ============================================================================
+//  Harness - a benchmark body processes `n` items and returns how many it
+//  did; the harness grows n until one run takes minTime, then reports the
+//  best of three runs of that size.
+// ============================================================================
+struct BenchOptions {
+    std::string filter;                   // run only benchmarks whose name contains this
+    double minTime = 0.5;                 // seconds per measured run
+    unsigned maxThreads = 0;              // 0 = hardware threads
+};
+
+class BenchRunner { // Times benchmark bodies and prints one row each
+public:
+    explicit BenchRunner(BenchOptions opt) : options(std::move(opt)) {
+        std::cout << "SIMD path: " << simdLevelName(simdLevel()) << " (cap with ROULETTE_SIMD=scalar|sse4.2|avx2|avx512)\n"
+            << std::left << std::setw(44) << "Benchmark" << std::right
+            << std::setw(14) << "items/s" << std::setw(12) << "ns/item" << std::setw(14) << "bytes/item" << "\n"
+            << std::string(84, '-') << "\n";
+    }
+
+    template<class Body>
+    void run(const std::string& name, Body&& body) {
+        if (!options.filter.empty() && name.find(options.filter) == std::string::npos) return;
+        std::uint64_t n = 1024;
+        for (;;) { // calibrate
+            const double t = timeOnce(body, n).seconds;
+            if (t >= options.minTime || n >= (1ull << 40)) break;
+            n = t > 0 ? std::max(n * 2, static_cast<std::uint64_t>(static_cast<double>(n) * options.minTime / t * 1.2)) : n * 16;
+        }
+        Sample best = timeOnce(body, n);
+        for (int rep = 1; rep < 3; ++rep) {
+            const Sample s = timeOnce(body, n);
+            if (s.seconds * static_cast<double>(best.items) < best.seconds * static_cast<double>(s.items)) best = s;
+        }
+        const double items = static_cast<double>(std::max<std::uint64_t>(best.items, 1));
+        std::cout << std::left << std::setw(44) << name << std::right << std::fixed
+            << std::setw(14) << std::setprecision(0) << items / best.seconds
+            << std::setw(12) << std::setprecision(2) << best.seconds * 1e9 / items
+            << std::setw(14) << std::setprecision(3) << static_cast<double>(best.bytes) / items << "\n";
+        std::cout.unsetf(std::ios::floatfield);
+    }
+
+    unsigned maxThreads() const { return options.maxThreads ? options.maxThreads : std::max(1u, std::thread::hardware_concurrency()); }
+
+private:
+    struct Sample { double seconds; std::uint64_t items, bytes; };
+
+    template<class Body>
+    static Sample timeOnce(Body& body, std::uint64_t n) {
+        const std::uint64_t before = allocatedBytes.load(std::memory_order_relaxed);
+        const auto start = std::chrono::steady_clock::now();
+        const std::uint64_t items = body(n);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return { seconds, items, allocatedBytes.load(std::memory_order_relaxed) - before };
+    }
+
+    BenchOptions options;
+};
+
+// ============================================================================
+//  Benchmarks
+// ============================================================================
+template<class Generator>
+void benchWheel(BenchRunner& bench, const std::string& name) { // spin(), spinIndex() and spinBatch() for one policy
+    bench.run("spin/" + name, [](std::uint64_t n) {
+        BasicRouletteWheel<Generator> wheel(1, 0);
+        std::uint64_t acc = 0;
+        for (std::uint64_t i = 0; i < n; ++i) acc += static_cast<std::uint64_t>(wheel.spin().number);
+        sink = sink + acc;
+        return n;
+    });
+    bench.run("spinIndex/" + name, [](std::uint64_t n) {
+        BasicRouletteWheel<Generator> wheel(1, 0);
+        std::uint64_t acc = 0;
+        for (std::uint64_t i = 0; i < n; ++i) acc += wheel.spinIndex();
+        sink = sink + acc;
+        return n;
+    });
+    bench.run("spinBatch/" + name, [](std::uint64_t n) {
+        BasicRouletteWheel<Generator> wheel(1, 0);
+        std::uint8_t block[64];
+        std::uint64_t acc = 0, done = 0;
+        for (; done < n; done += sizeof block) { wheel.spinBatch(block); acc += block[0]; }
+        sink = sink + acc;
+        return done;
+    });
+}
+
+StrategyConfig benchConfig() { // The default strategy the app starts with
+    StrategyConfig c;
+    c.bankroll = 5000.0; c.lossThreshold = 3; c.initialBet = 100.0; c.maxBet = 10000.0;
+    return c;
+}
+
+// Kernel steps over a pre-drawn pocket buffer, restarting the session whenever it ends
+void benchKernel(BenchRunner& bench) {
+    std::vector<std::uint8_t> pockets(1 << 16), classes(1 << 16);
+    RouletteWheel wheel(3, 0);
+    for (std::size_t i = 0; i < pockets.size(); i += 64) wheel.spinBatch(std::span<std::uint8_t>(pockets.data() + i, 64));
+    classifyPockets(pockets, classes);
+    const StrategyParams params = makeStrategyParams(benchConfig());
+
+    bench.run("stepSession", [&](std::uint64_t n) {
+        SessionState s = startSession(params);
+        const std::size_t mask = pockets.size() - 1;
+        for (std::uint64_t i = 0; i < n; ++i) {
+            stepSession(s, params, pockets[i & mask], classes[i & mask]);
+            if (!sessionActive(s)) s = startSession(params);
+        }
+        sink = sink + s.spins;
+        return n;
+    });
+    bench.run("stepSession+StatsTracker<10>", [&](std::uint64_t n) {
+        SessionState s = startSession(params);
+        StatsTracker stats;
+        const std::size_t mask = pockets.size() - 1;
+        for (std::uint64_t i = 0; i < n; ++i) {
+            const StepResult r = stepSession(s, params, pockets[i & mask], classes[i & mask]);
+            stats.recordSpin(pockets[i & mask], r, s);
+            if (!sessionActive(s)) s = startSession(params);
+        }
+        sink = sink + static_cast<std::uint64_t>(stats.spins());
+        return n;
+    });
+}
+
+// A recorded log decoded on its own, then replayed through the kernel; items are spins
+void benchSpinLog(BenchRunner& bench) {
+    const std::string path = (std::filesystem::temp_directory_path() / "roulette-bench.rspl").string();
+    recordSpinLog(path, GeneratorKind::XOSHIRO256X8, 11, 0, 3u << 20);
+    {
+        const SpinLogReader log(path);
+        bench.run("spinLog/decode", [&](std::uint64_t n) {
+            std::uint8_t block[3 * 1024];
+            std::uint64_t acc = 0, done = 0;
+            for (std::size_t word = 0; done < n; word = word + 1024 < log.words().size() ? word + 1024 : 0) {
+                done += log.decode(word, block);
+                acc += block[0];
+            }
+            sink = sink + acc;
+            return done;
+        });
+        const StrategyConfig config = benchConfig();
+        bench.run("spinLog/replay", [&](std::uint64_t n) {
+            std::uint64_t done = 0;
+            while (done < n) replaySessions(log, config, [&](const SessionResult& r) { done += static_cast<std::uint64_t>(r.spins); });
+            return done;
+        });
+    }
+    std::error_code e;
+    std::filesystem::remove(path, e);
+}
+
+// Whole batches through the engine; items are spins, so short and long sessions compare
+void benchBatch(BenchRunner& bench) {
+    const SimulationEngine engine(benchConfig());
+    std::vector<unsigned> counts;
+    for (unsigned t = 1; t < bench.maxThreads(); t *= 2) counts.push_back(t);
+    counts.push_back(bench.maxThreads());
+    for (SteppingMode mode : { SteppingMode::SCALAR, SteppingMode::LANES })
+        for (unsigned t : counts) {
+            const std::string name = std::string("batch/") + (mode == SteppingMode::LANES ? "lanes" : "scalar") + "/threads:" + std::to_string(t);
+            bench.run(name, [&, mode, t](std::uint64_t n) {
+                BatchOptions opt;
+                opt.sessions = std::max<std::uint64_t>(n / 40, 1); // about 40 spins per session
+                opt.masterSeed = 11; opt.threads = t; opt.stepping = mode;
+                return engine.run(opt).totalSpins;
+            });
+        }
+    bench.run("batch/scalar-cents/threads:1", [&](std::uint64_t n) { // integer-cent kernel against the double row above
+        BatchOptions opt;
+        opt.sessions = std::max<std::uint64_t>(n / 40, 1);
+        opt.masterSeed = 11; opt.threads = 1; opt.stepping = SteppingMode::SCALAR; opt.accounting = Accounting::CENTS;
+        return engine.run(opt).totalSpins;
+    });
+    StrategyConfig sided = benchConfig(); // ten side chips: one payout-table gather per spin instead of the green blend
+    sided.sideBets = BetLayout::parse("straight 17 1; split 8 9 1; split 20 23 1; street 13 1; corner 25 1; dozen 2 1; column 3 1; odd 1; low 1; high 1");
+    const SimulationEngine sidedEngine(sided);
+    for (SteppingMode mode : { SteppingMode::SCALAR, SteppingMode::LANES })
+        bench.run(std::string("batch/") + (mode == SteppingMode::LANES ? "lanes" : "scalar") + "-side-bets/threads:1", [&, mode](std::uint64_t n) {
+            BatchOptions opt;
+            opt.sessions = std::max<std::uint64_t>(n / 40, 1);
+            opt.masterSeed = 11; opt.threads = 1; opt.stepping = mode;
+            return sidedEngine.run(opt).totalSpins;
+        });
+    StrategyConfig scripted = benchConfig(); // the same rules as a strategy program: bytecode per spin against the kernel's scalar row
+    scripted.program = multiplierStrategySource(scripted);
+    const SimulationEngine scriptedEngine(scripted);
+    bench.run("batch/program/threads:1", [&](std::uint64_t n) {
+        BatchOptions opt;
+        opt.sessions = std::max<std::uint64_t>(n / 40, 1);
+        opt.masterSeed = 11; opt.threads = 1;
+        return scriptedEngine.run(opt).totalSpins;
+    });
+}
+
+// ============================================================================
+//  main
+// ============================================================================
+int main(int argc, char** argv) {
+    BenchOptions opt;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (a == "--filter" && i + 1 < argc) opt.filter = argv[++i];
+        else if (a == "--min-time" && i + 1 < argc) opt.minTime = std::atof(argv[++i]);
+        else if (a == "--threads" && i + 1 < argc) opt.maxThreads = static_cast<unsigned>(std::atoi(argv[++i]));
+        else {
+            std::cout << "Usage: " << argv[0] << " [--filter text] [--min-time seconds] [--threads N]\n";
+            return a == "--help" ? 0 : 1;
+        }
+    }
+
+    BenchRunner bench(opt);
+    benchWheel<Xoshiro256PlusPlus>(bench, "xoshiro256++");
+    benchWheel<Xoshiro256x8>(bench, "xoshiro256++x8");
+    benchWheel<Philox4x32>(bench, "philox4x32");
+    benchWheel<Mt19937Generator>(bench, "mt19937");
+    benchKernel(bench);
+    benchSpinLog(bench);
+    benchBatch(bench);
+    return 0;
+}
@@ -0,0 +1,210 @@
+// ============================================================================
+//  BetLayout.h - side bets on the table layout: any mix of straight, split,
+//  street, corner, dozen, column and even-money chips, placed every spin next
+//  to the strategy's color bet. A layout is compiled once per strategy into a
+//  payout table - the net result of all its chips for each pocket - so the
+//  kernel settles any number of chips with one table load.
+//  Build:  C++20, Visual Studio 2022 (x64, Windows)
+// ============================================================================
+#pragma once
+
+#include "HostDevice.h"
+#include "Money.h"
+#include "RouletteCore.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+enum class BetKind : std::uint8_t { STRAIGHT, SPLIT, STREET, CORNER, DOZEN, COLUMN, RED, BLACK, ODD, EVEN, LOW, HIGH };
+
+struct BetChip { // One chip on the layout
+    BetKind kind = BetKind::STRAIGHT;
+    int number = 0;                       // straight: pocket; split, street, corner: lowest number; dozen, column: 1-3
+    int second = 0;                       // split: the other number
+    double amount = 0.0;                  // dollars on the chip
+};
+
+constexpr int betPayout(BetKind k) { // Winnings per dollar staked
+    switch (k) {
+    case BetKind::STRAIGHT: return 35;
+    case BetKind::SPLIT: return 17;
+    case BetKind::STREET: return 11;
+    case BetKind::CORNER: return 8;
+    case BetKind::DOZEN: case BetKind::COLUMN: return 2;
+    default: return 1;
+    }
+}
+
+// Pockets a chip covers, bit n = pocket n; throws std::invalid_argument for a chip that is not on the table
+inline std::uint64_t betCoverage(const BetChip& c) {
+    auto numbersWhere = [](auto&& covered) { // subset of 1..36
+        std::uint64_t m = 0;
+        for (int n = 1; n <= 36; ++n) if (covered(n)) m |= 1ull << n;
+        return m;
+    };
+    const int n = c.number;
+    const bool onTable = n >= 1 && n <= 36;
+    switch (c.kind) {
+    case BetKind::STRAIGHT:
+        if (n < 0 || n >= maxWheelPockets) throw std::invalid_argument("Straight bet on a pocket that does not exist");
+        return 1ull << n;
+    case BetKind::SPLIT: {
+        const int lo = std::min(n, c.second), hi = std::max(n, c.second);
+        if (!(lo >= 1 && hi <= 36 && (hi - lo == 3 || (hi - lo == 1 && lo % 3 != 0))))
+            throw std::invalid_argument("A split covers two neighbouring numbers");
+        return (1ull << lo) | (1ull << hi);
+    }
+    case BetKind::STREET:
+        if (!onTable || n % 3 != 1) throw std::invalid_argument("A street starts at 1, 4, ... or 34");
+        return 7ull << n;
+    case BetKind::CORNER:
+        if (!onTable || n % 3 == 0 || n > 32) throw std::invalid_argument("A corner is named by its lowest number, 1-32, not in the third column");
+        return (3ull << n) | (3ull << (n + 3));
+    case BetKind::DOZEN:
+        if (n < 1 || n > 3) throw std::invalid_argument("Dozens are 1, 2 and 3");
+        return numbersWhere([n](int k) { return (k - 1) / 12 == n - 1; });
+    case BetKind::COLUMN:
+        if (n < 1 || n > 3) throw std::invalid_argument("Columns are 1, 2 and 3");
+        return numbersWhere([n](int k) { return (k - 1) % 3 == n - 1; });
+    case BetKind::RED: return redPocketMask;
+    case BetKind::BLACK: return numbersWhere([](int k) { return !((redPocketMask >> k) & 1); });
+    case BetKind::ODD: return numbersWhere([](int k) { return k % 2 == 1; });
+    case BetKind::EVEN: return numbersWhere([](int k) { return k % 2 == 0; });
+    case BetKind::LOW: return numbersWhere([](int k) { return k <= 18; });
+    case BetKind::HIGH: return numbersWhere([](int k) { return k > 18; });
+    }
+    throw std::invalid_argument("Unknown bet kind");
+}
+
+// ============================================================================
+//  BetLayout
+//  Chips are checked as they are added; whether every pocket exists on the
+//  chosen wheel is checked when the layout is compiled.
+// ============================================================================
+class BetLayout { // Chips placed every spin
+public:
+    BetLayout& add(const BetChip& c) {
+        if (!(c.amount > 0 && std::isfinite(c.amount))) throw std::invalid_argument("A chip needs a positive amount");
+        (void)betCoverage(c); // throws for a chip that is not on the table
+        chips_.push_back(c);
+        return *this;
+    }
+    BetLayout& add(const BetLayout& other) { for (const BetChip& c : other.chips_) add(c); return *this; }
+
+    BetLayout& straight(int pocket, double amount) { return add({ BetKind::STRAIGHT, pocket, 0, amount }); }
+    BetLayout& split(int a, int b, double amount) { return add({ BetKind::SPLIT, a, b, amount }); }
+    BetLayout& street(int first, double amount) { return add({ BetKind::STREET, first, 0, amount }); }
+    BetLayout& corner(int lowest, double amount) { return add({ BetKind::CORNER, lowest, 0, amount }); }
+    BetLayout& dozen(int k, double amount) { return add({ BetKind::DOZEN, k, 0, amount }); }
+    BetLayout& column(int k, double amount) { return add({ BetKind::COLUMN, k, 0, amount }); }
+    BetLayout& evenMoney(BetKind k, double amount) { return add({ k, 0, 0, amount }); } // RED, BLACK, ODD, EVEN, LOW, HIGH
+
+    static BetLayout zeros(int wheelZeros, double amount) { // One chip straight up on each zero
+        BetLayout l;
+        for (int z = 0; z < wheelZeros; ++z) l.straight(z ? 36 + z : 0, amount);
+        return l;
+    }
+
+    // "straight 17 5; split 8 9 2.5; dozen 2 10; red 1" - kind, its numbers, then the amount.
+    // Straight bets take 0, 00 and 000; throws std::invalid_argument on anything else.
+    static BetLayout parse(const std::string& text) {
+        BetLayout l;
+        std::istringstream all(text);
+        for (std::string item; std::getline(all, item, ';'); ) {
+            std::istringstream words(item);
+            std::vector<std::string> w;
+            for (std::string s; words >> s; ) w.push_back(s);
+            if (w.empty()) continue;
+            const BetKind kind = kindFromName(w[0]);
+            const std::size_t numbers = kind == BetKind::SPLIT ? 2 : kind <= BetKind::COLUMN ? 1 : 0;
+            if (w.size() != numbers + 2) throw std::invalid_argument("Expected " + std::to_string(numbers) + " number(s) and an amount: " + item);
+            BetChip c;
+            c.kind = kind;
+            if (numbers > 0) c.number = parsePocket(w[1]);
+            if (numbers > 1) c.second = parsePocket(w[2]);
+            c.amount = parseAmount(w.back());
+            l.add(c);
+        }
+        return l;
+    }
+
+    const std::vector<BetChip>& chips() const { return chips_; }
+    bool empty() const { return chips_.empty(); }
+    double stake() const { double s = 0; for (const BetChip& c : chips_) s += c.amount; return s; } // dollars wagered per spin
+
+private:
+    static BetKind kindFromName(const std::string& s) {
+        static const char* const names[] = { "straight", "split", "street", "corner", "dozen", "column", "red", "black", "odd", "even", "low", "high" };
+        for (std::size_t k = 0; k < std::size(names); ++k) if (s == names[k]) return static_cast<BetKind>(k);
+        throw std::invalid_argument("Unknown bet: " + s);
+    }
+    static int parsePocket(const std::string& s) {
+        if (s == "00") return 37;
+        if (s == "000") return 38;
+        if (s.empty() || s.size() > 2 || !std::all_of(s.begin(), s.end(), [](char ch) { return ch >= '0' && ch <= '9'; }))
+            throw std::invalid_argument("Not a number on the layout: " + s);
+        return std::stoi(s);
+    }
+    static double parseAmount(const std::string& s) {
+        std::size_t used = 0;
+        double a = 0;
+        try { a = std::stod(s, &used); }
+        catch (const std::exception&) { used = 0; }
+        if (used != s.size()) throw std::invalid_argument("Not an amount: " + s);
+        return a;
+    }
+
+    std::vector<BetChip> chips_;
+};
+
+class ExtraBetMode { // Extra-bet mode class: $1 straight up on each zero
+public:
+    explicit ExtraBetMode(bool en = false, int wheelZeros = AmericanLayout::zeros) : enabled(en), zeros(wheelZeros) {}
+    bool isEnabled() const { return enabled; }
+    double extraBetAmount() const { return enabled ? zeros : 0.0; }
+    BetLayout layout() const { return enabled ? BetLayout::zeros(zeros, 1.0) : BetLayout(); }
+private:
+    bool enabled;
+    int zeros;
+};
+
+// ----------------------------------------------------------------------------
+//  Payout table - a compiled layout. net[pocket] is the bankroll change from
+//  every chip when the ball lands in `pocket`; each chip adds its winnings on
+//  the pockets it covers and loses its stake on the rest. greenOnly marks
+//  the common case (no chips, or chips on the zeros only) where one green /
+//  not-green choice settles the spin, which the lane stepper uses to skip
+//  the per-lane gather.
+// ----------------------------------------------------------------------------
+template<class Money>
+struct BasicPayoutTable {
+    using Amount = typename Money::Amount;
+    std::array<Amount, maxWheelPockets> net{}; // by pocket; zero past the wheel's last pocket
+    Amount worst{};                       // most negative entry, or zero
+    bool greenOnly = true;                // every green pocket pays net[0] and every other pocket net[1]
+    ROULETTE_HOST_DEVICE Amount operator[](int pocket) const { return net[pocket]; }
+};
+
+template<class Money = DollarMoney>
+BasicPayoutTable<Money> compilePayouts(const BetLayout& layout, WheelKind wheel) {
+    const int pockets = wheelPocketCount(wheel);
+    BasicPayoutTable<Money> t;
+    for (const BetChip& c : layout.chips()) {
+        const std::uint64_t covered = betCoverage(c);
+        if (covered >> pockets) throw std::invalid_argument("Bet on a pocket this wheel does not have: " + numberToString(c.number));
+        const auto win = Money::fromDollars(c.amount * betPayout(c.kind)), lose = -Money::fromDollars(c.amount);
+        for (int n = 0; n < pockets; ++n) t.net[n] += ((covered >> n) & 1) ? win : lose;
+    }
+    for (int n = 0; n < pockets; ++n) {
+        t.worst = std::min(t.worst, t.net[n]);
+        if (t.net[n] != t.net[isGreenPocket(n) ? 0 : 1]) t.greenOnly = false;
+    }
+    return t;
+}
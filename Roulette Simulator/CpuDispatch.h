@@ -0,0 +1,94 @@
+// ============================================================================
+//  CpuDispatch.h - runtime choice of the widest vector path the CPU runs. On
+//  x86-64 the AVX-512, AVX2 and SSE4.2 kernels are compiled into every build
+//  (GCC and Clang through target attributes; MSVC takes the intrinsics as
+//  they are) and one is picked per process from CPUID, so a baseline x86-64
+//  binary is still fast on a wide machine. ROULETTE_SIMD=scalar|sse4.2|avx2|
+//  avx512 in the environment caps the choice, to compare paths on one box.
+//  Defining ROULETTE_NO_DISPATCH keeps only what the compiler flags enable.
+//  AArch64 always has NEON, so that path stays a compile-time one.
+//  Build:  C++20, Visual Studio 2022 (x64, Windows)
+// ============================================================================
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+
+#if (defined(__x86_64__) || defined(_M_X64)) && !defined(ROULETTE_NO_DISPATCH) && !defined(__CUDACC__)
+#define ROULETTE_X86_DISPATCH 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// Which kernels exist in this build; simdLevel() says which of them may run
+#if defined(ROULETTE_X86_DISPATCH) || defined(__AVX512F__)
+#define ROULETTE_SIMD_AVX512 1
+#endif
+#if defined(ROULETTE_X86_DISPATCH) || defined(__AVX2__)
+#define ROULETTE_SIMD_AVX2 1
+#endif
+#if defined(ROULETTE_X86_DISPATCH) || defined(__SSE4_2__)
+#define ROULETTE_SIMD_SSE42 1
+#endif
+
+#if defined(ROULETTE_X86_DISPATCH) && (defined(__GNUC__) || defined(__clang__))
+#define ROULETTE_TARGET(isa) __attribute__((target(isa))) // compile this function for `isa` only
+#else
+#define ROULETTE_TARGET(isa)
+#endif
+
+enum class SimdLevel : std::uint8_t { SCALAR, SSE42, AVX2, AVX512 };
+
+inline const char* simdLevelName(SimdLevel s) { // Short label, as ROULETTE_SIMD spells it
+    switch (s) { case SimdLevel::SSE42: return "sse4.2"; case SimdLevel::AVX2: return "avx2"; case SimdLevel::AVX512: return "avx512"; default: return "scalar"; }
+}
+
+// What the compiler flags alone guarantee
+inline constexpr SimdLevel compiledSimdLevel =
+#if defined(__AVX512F__)
+    SimdLevel::AVX512;
+#elif defined(__AVX2__)
+    SimdLevel::AVX2;
+#elif defined(__SSE4_2__)
+    SimdLevel::SSE42;
+#else
+    SimdLevel::SCALAR;
+#endif
+
+inline SimdLevel detectSimdLevel() { // The CPU and OS together: AVX needs the OS to save ymm/zmm state
+#if defined(ROULETTE_X86_DISPATCH) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init(); // may run before static constructors
+    if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+    if (__builtin_cpu_supports("sse4.2")) return SimdLevel::SSE42;
+    return SimdLevel::SCALAR;
+#elif defined(ROULETTE_X86_DISPATCH)
+    int r[4];
+    __cpuid(r, 0);
+    const int maxLeaf = r[0];
+    __cpuid(r, 1);
+    const bool sse42 = (r[2] >> 20) & 1, osxsave = (r[2] >> 27) & 1;
+    const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+    int leaf7[4] = {};
+    if (maxLeaf >= 7) __cpuidex(leaf7, 7, 0);
+    if ((leaf7[1] >> 16) & 1 && (xcr0 & 0xE6) == 0xE6) return SimdLevel::AVX512; // opmask, zmm upper halves and zmm16-31
+    if ((leaf7[1] >> 5) & 1 && (xcr0 & 6) == 6) return SimdLevel::AVX2;
+    return sse42 ? SimdLevel::SSE42 : SimdLevel::SCALAR;
+#else
+    return compiledSimdLevel;
+#endif
+}
+
+inline SimdLevel simdLevel() { // Detected once, then capped by ROULETTE_SIMD
+    static const SimdLevel level = [] {
+        SimdLevel s = detectSimdLevel();
+        if (const char* cap = std::getenv("ROULETTE_SIMD"))
+            for (SimdLevel c : { SimdLevel::SCALAR, SimdLevel::SSE42, SimdLevel::AVX2, SimdLevel::AVX512 })
+                if (std::strcmp(cap, simdLevelName(c)) == 0 && c < s) s = c;
+        return s;
+    }();
+    return level;
+}
@@ -0,0 +1,262 @@
+// ============================================================================
+//  DistributedSweep.h - the grid sweep spread over machines. A coordinator
+//  runs SweepRunner's rounds and pruning, but splits each round into shards of
+//  (configuration, session range, master seed) and hands them to workers over
+//  TCP; workers run the shard through SimulationEngine and send back the
+//  BatchResult with its sketch. A worker that disconnects or goes silent
+//  loses its shard to the queue, and another worker picks it up.
+//  Build:  C++20, Visual Studio 2022 (x64, Windows)
+// ============================================================================
+#pragma once
+
+#include "SimulationEngine.h"
+#include "StrategyKernel.h"
+#include "SweepRunner.h"
+#include "Wire.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct DistributedOptions { // Transport and shard sizing
+    std::uint16_t port = 5150;            // coordinator listens here
+    std::uint64_t shardSessions = 65536;  // sessions per shard; merging is exact at any size
+    std::chrono::seconds shardTimeout{ 3600 }; // a worker silent this long is presumed dead
+};
+
+struct SweepShard { // One unit of work: sessions [firstSession, firstSession + sessions) of one configuration
+    std::uint64_t id = 0;
+    StrategyConfig config;
+    std::uint64_t masterSeed = 0, firstSession = 0, sessions = 0;
+    std::uint8_t generator = 0;           // GeneratorKind
+};
+
+template<class Archive>
+void transfer(Archive& ar, SweepShard& s) {
+    ar(s.id); transfer(ar, s.config); ar(s.masterSeed); ar(s.firstSession); ar(s.sessions); ar(s.generator);
+}
+
+enum class SweepMessage : std::uint8_t { HELLO = 1, SHARD, RESULT, DONE };
+inline constexpr std::uint32_t sweepProtocolVersion = 4; // 2: configurations carry their wheel; 3: and side bets; 4: and a program
+
+template<class... Parts>
+std::string sweepMessage(SweepMessage type, Parts&... parts) { // Type byte, then each part's transfer()
+    WireWriter w;
+    w(static_cast<std::uint8_t>(type));
+    (transfer(w, parts), ...);
+    return w.data();
+}
+
+// ============================================================================
+//  SweepCoordinator
+//  Shard sessions come from the same (masterSeed, session) streams as a local
+//  sweep and every shard of a round is merged in session order before
+//  pruning, so counts, ruin estimates and pruning decisions equal
+//  SweepRunner's on one box. Only the floating sums are added in a different
+//  order: shard by shard instead of chunk by chunk.
+// ============================================================================
+class SweepCoordinator { // Hands sweep shards to remote workers
+public:
+    SweepCoordinator(SweepOptions sweep, DistributedOptions net, std::ostream* log = nullptr) : options(sweep), network(net), events(log) {}
+
+    SweepResult run(const SweepGrid& grid) {
+        SweepResult out;
+        for (auto& c : grid.expand()) { SweepEntry e; e.config = std::move(c); out.entries.push_back(std::move(e)); }
+        out.naiveSessions = options.maxSessions * out.entries.size();
+        std::vector<std::size_t> live(out.entries.size());
+        for (std::size_t i = 0; i < live.size(); ++i) live[i] = i;
+
+        const Socket listener = Socket::listen(network.port);
+        log("Waiting for workers on port " + std::to_string(network.port));
+        std::thread acceptor([&] { acceptLoop(listener); });
+        try {
+            std::uint64_t done = 0, target = std::min(std::max<std::uint64_t>(options.firstRound, 1), options.maxSessions);
+            while (!live.empty() && done < options.maxSessions) {
+                ++out.rounds;
+                if (options.telemetry) options.telemetry->setTarget(out.totalSessions + live.size() * (options.maxSessions - done));
+                std::vector<SweepShard> shards; // Extend every survivor to `target` sessions
+                std::vector<std::size_t> owner;
+                for (std::size_t i : live)
+                    for (std::uint64_t first = done; first < target; first += network.shardSessions) {
+                        SweepShard s;
+                        s.id = nextShardId++; s.config = out.entries[i].config; s.masterSeed = options.masterSeed;
+                        s.firstSession = first; s.sessions = std::min(network.shardSessions, target - first);
+                        s.generator = static_cast<std::uint8_t>(options.generator);
+                        shards.push_back(std::move(s)); owner.push_back(i);
+                    }
+                const std::vector<BatchResult> results = runRound(std::move(shards));
+                for (std::size_t k = 0; k < results.size(); ++k) { // session order within each configuration
+                    SweepEntry& e = out.entries[owner[k]];
+                    mergeBatchResult(e.detail, results[k]);
+                    e.sessions += results[k].sessions; e.ruined += results[k].ruined; e.finalSum += results[k].finalSum;
+                    out.totalSessions += results[k].sessions;
+                }
+                done = target;
+                if (done < options.maxSessions) pruneSweep(out.entries, live, out.rounds, options);
+                target = std::min(options.maxSessions, target * 2);
+            }
+        }
+        catch (...) { shutdown(acceptor); throw; }
+        shutdown(acceptor);
+        rankSweep(out.entries);
+        return out;
+    }
+
+    std::uint64_t requeuedShards() const { return requeued; } // shards lost with a worker and sent again
+    unsigned workersSeen() const { return workers; }
+
+private:
+    // Publish a round's shards and block until every one has a result
+    std::vector<BatchResult> runRound(std::vector<SweepShard> shards) {
+        std::unique_lock<std::mutex> lock(m);
+        round = std::move(shards);
+        results.assign(round.size(), BatchResult());
+        received.assign(round.size(), 0);
+        outstanding = round.size();
+        queue.clear();
+        for (std::size_t k = 0; k < round.size(); ++k) queue.push_back(k);
+        changed.notify_all();
+        changed.wait(lock, [&] { return outstanding == 0; });
+        return std::move(results);
+    }
+
+    void acceptLoop(const Socket& listener) {
+        for (;;) {
+            { std::lock_guard<std::mutex> lock(m); if (finished) break; }
+            Socket c = listener.accept(std::chrono::milliseconds(200));
+            if (!c.valid()) continue;
+            std::lock_guard<std::mutex> lock(m);
+            ++workers;
+            connections.emplace_back([this, s = std::move(c)]() mutable { serve(std::move(s)); });
+        }
+    }
+
+    void shutdown(std::thread& acceptor) { // Release idle workers with DONE and join every thread
+        { std::lock_guard<std::mutex> lock(m); finished = true; }
+        changed.notify_all();
+        acceptor.join();
+        for (auto& t : connections) t.join();
+        connections.clear();
+    }
+
+    // One worker connection: hand out shards until the sweep ends or the worker fails
+    void serve(Socket s) {
+        try {
+            s.setReceiveTimeout(std::chrono::duration_cast<std::chrono::milliseconds>(network.shardTimeout));
+            const std::string hello = s.receiveFrame();
+            WireReader r(hello);
+            std::uint8_t type = 0; std::uint32_t version = 0;
+            r(type); r(version);
+            if (type != static_cast<std::uint8_t>(SweepMessage::HELLO) || version != sweepProtocolVersion)
+                throw std::runtime_error("Worker speaks a different protocol version");
+            for (;;) {
+                std::size_t k;
+                SweepShard shard;
+                {
+                    std::unique_lock<std::mutex> lock(m);
+                    changed.wait(lock, [&] { return finished || !queue.empty(); });
+                    if (queue.empty()) break; // finished
+                    k = queue.front(); queue.pop_front();
+                    shard = round[k];
+                }
+                BatchResult result;
+                try {
+                    s.sendFrame(sweepMessage(SweepMessage::SHARD, shard));
+                    const std::string reply = s.receiveFrame();
+                    WireReader in(reply);
+                    std::uint64_t id = 0;
+                    in(type); in(id); transfer(in, result);
+                    if (type != static_cast<std::uint8_t>(SweepMessage::RESULT) || id != shard.id || result.sessions != shard.sessions || !in.finished())
+                        throw std::runtime_error("Unexpected reply to shard " + std::to_string(shard.id));
+                }
+                catch (...) { // back to the front of the queue for the next free worker
+                    { std::lock_guard<std::mutex> lock(m); queue.push_front(k); ++requeued; }
+                    changed.notify_all();
+                    throw;
+                }
+                if (options.telemetry) options.telemetry->slot(0).addSessions(result.sessions, result.totalSpins, result.ruined);
+                {
+                    std::lock_guard<std::mutex> lock(m);
+                    if (!received[k]) { results[k] = std::move(result); received[k] = 1; --outstanding; }
+                }
+                changed.notify_all();
+            }
+            s.sendFrame(sweepMessage(SweepMessage::DONE));
+        }
+        catch (const std::exception& e) {
+            log(std::string("Worker dropped: ") + e.what());
+        }
+    }
+
+    void log(const std::string& line) {
+        std::lock_guard<std::mutex> lock(logLock);
+        if (events) *events << line << "\n";
+    }
+
+    SweepOptions options;
+    DistributedOptions network;
+    std::ostream* events;
+    std::mutex logLock;
+
+    std::mutex m;                         // guards everything below
+    std::condition_variable changed;      // queue, results or finished changed
+    std::vector<SweepShard> round;        // this round's shards
+    std::vector<BatchResult> results;
+    std::vector<char> received;
+    std::deque<std::size_t> queue;        // shards not yet handed out (or handed back)
+    std::size_t outstanding = 0;
+    bool finished = false;
+    std::vector<std::thread> connections;
+    std::uint64_t nextShardId = 1, requeued = 0;
+    unsigned workers = 0;
+};
+
+// ============================================================================
+//  runSweepWorker - connect to a coordinator and run shards until it sends
+//  DONE. A lost connection is retried every retryDelay, up to `retries` times
+//  in a row; returns the number of shards this worker completed.
+// ============================================================================
+inline std::uint64_t runSweepWorker(const std::string& host, std::uint16_t port, unsigned threads, std::ostream& log,
+    int retries = 30, std::chrono::seconds retryDelay = std::chrono::seconds(2)) {
+    std::uint64_t completed = 0;
+    for (int failures = 0; ; ) {
+        try {
+            Socket s = Socket::connect(host, port);
+            failures = 0;
+            WireWriter hello;
+            hello(static_cast<std::uint8_t>(SweepMessage::HELLO)); hello(sweepProtocolVersion);
+            s.sendFrame(hello.data());
+            log << "Connected to " << host << ":" << port << "\n";
+            for (;;) {
+                const std::string frame = s.receiveFrame();
+                WireReader in(frame);
+                std::uint8_t type = 0;
+                in(type);
+                if (type == static_cast<std::uint8_t>(SweepMessage::DONE)) return completed;
+                if (type != static_cast<std::uint8_t>(SweepMessage::SHARD)) throw std::runtime_error("Unexpected message from coordinator");
+                SweepShard shard;
+                transfer(in, shard);
+                BatchOptions b;
+                b.sessions = shard.sessions; b.firstSession = shard.firstSession; b.masterSeed = shard.masterSeed;
+                b.threads = threads; b.generator = static_cast<GeneratorKind>(shard.generator);
+                BatchResult result = SimulationEngine(shard.config).run(b);
+                s.sendFrame(sweepMessage(SweepMessage::RESULT, shard.id, result));
+                ++completed;
+            }
+        }
+        catch (const std::exception& e) {
+            if (++failures > retries) throw;
+            log << e.what() << "; retrying in " << retryDelay.count() << " s\n";
+            std::this_thread::sleep_for(retryDelay);
+        }
+    }
+}
@@ -0,0 +1,67 @@
+// ============================================================================
+//  GpuEngine.cu - CUDA side of GpuEngine.h. Each thread plays one session:
+//  Philox4x32 seeded with (masterSeed, stream), one bounded draw per spin,
+//  stepSession() until the session ends. The draws and the arithmetic are the
+//  host code's, so every session should match its CPU replay bit for bit.
+//  Experimental: not yet compiled or checked against the CPU engine, and
+//  not part of any build target until it is.
+//  Build:  nvcc -std=c++20 --expt-relaxed-constexpr -DROULETTE_CUDA
+// ============================================================================
+#include "GpuEngine.h"
+
+#include <cuda_runtime.h>
+
+#include <mutex>
+#include <string>
+
+namespace {
+
+__constant__ std::uint8_t devicePocketClass[maxWheelPockets]; // pocketClassTable, for device lookups
+
+template<class Layout>
+__global__ void playSessionsKernel(StrategyParams p, std::uint64_t masterSeed, std::uint64_t firstStream, std::uint64_t count, GpuSessionRecord* out) {
+    const std::uint64_t i = static_cast<std::uint64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    if (i >= count) return;
+    Philox4x32 rng;
+    rng.seed(masterSeed, firstStream + i);
+    SessionState s = startSession(p);
+    while (sessionActive(s)) {
+        const auto pocket = static_cast<std::uint8_t>(boundedRandom(rng, Layout::pockets));
+        stepSession(s, p, pocket, devicePocketClass[pocket]);
+    }
+    out[i] = { s.bankroll, s.spins, s.maxBetHits, s.longestLossStreak, sessionRuined(s) ? 1 : 0 };
+}
+
+void check(cudaError_t e, const char* what) { // CUDA status to the engine's exceptions
+    if (e != cudaSuccess) throw std::runtime_error(std::string(what) + ": " + cudaGetErrorString(e));
+}
+
+} // namespace
+
+GpuResultBuffer::GpuResultBuffer(std::uint64_t sessions) : capacity(sessions) {
+    if (sessions) check(cudaMalloc(&device, sessions * sizeof(GpuSessionRecord)), "Allocating session results");
+}
+GpuResultBuffer::~GpuResultBuffer() { cudaFree(device); }
+
+bool gpuAvailable() {
+    int devices = 0;
+    return cudaGetDeviceCount(&devices) == cudaSuccess && devices > 0;
+}
+
+void gpuPlaySessions(const StrategyParams& params, WheelKind wheel, std::uint64_t masterSeed, std::uint64_t firstStream, std::uint64_t count,
+    GpuResultBuffer& results, GpuSessionRecord* out) {
+    if (count == 0) return;
+    if (count > results.size()) throw std::runtime_error("Session results do not fit the device buffer");
+    static std::once_flag tableCopied;
+    std::call_once(tableCopied, [] { check(cudaMemcpyToSymbol(devicePocketClass, pocketClassTable.data(), maxWheelPockets), "Copying the pocket table"); });
+
+    GpuSessionRecord* const device = results.data();
+    constexpr unsigned threadsPerBlock = 256;
+    const auto blocks = static_cast<unsigned>((count + threadsPerBlock - 1) / threadsPerBlock);
+    withWheelLayout(wheel, [&](auto layout) {
+        playSessionsKernel<decltype(layout)><<<blocks, threadsPerBlock>>>(params, masterSeed, firstStream, count, device);
+    });
+    cudaError_t status = cudaGetLastError();
+    if (status == cudaSuccess) status = cudaMemcpy(out, device, count * sizeof(GpuSessionRecord), cudaMemcpyDeviceToHost);
+    check(status, "Running the session kernel");
+}
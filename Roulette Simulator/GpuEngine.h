@@ -0,0 +1,114 @@
+// ============================================================================
+//  GpuEngine.h - the session farm on a CUDA device: one GPU thread per
+//  session, each drawing from its own Philox4x32 stream and stepping the
+//  shared kernel (StrategyKernel.h, compiled for both sides). Per-session
+//  results come back in launches and are folded on the host into the same
+//  counters, chunk sums and sketch as SimulationEngine, so a GPU batch equals
+//  a CPU batch run with GeneratorKind::PHILOX4X32, session for session.
+//  The device code is GpuEngine.cu, built only when ROULETTE_CUDA is defined;
+//  without it gpuAvailable() is false and run() throws.
+//  EXPERIMENTAL: GpuEngine.cu has not yet been compiled or run against the
+//  CPU engine, so the session-for-session match above is the design, not a
+//  checked result. No target builds it and no job option reaches it until
+//  it is built and a test compares it with the CPU engine's Philox batches.
+//  Build:  C++20, Visual Studio 2022 (x64, Windows)
+// ============================================================================
+#pragma once
+
+#include "SimulationEngine.h"
+#include "StrategyKernel.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+struct GpuSessionRecord { // One session as the device writes it, 24 bytes
+    double finalBankroll;
+    std::int32_t spins, maxBetHits, longestLossStreak, ruined;
+};
+
+class GpuResultBuffer { // Device memory for `sessions` records, held for a whole GpuEngine::run()
+public:
+    explicit GpuResultBuffer(std::uint64_t sessions); // throws std::runtime_error if it cannot be allocated
+    ~GpuResultBuffer();
+    GpuResultBuffer(const GpuResultBuffer&) = delete;
+    GpuResultBuffer& operator=(const GpuResultBuffer&) = delete;
+    GpuSessionRecord* data() const { return device; }
+    std::uint64_t size() const { return capacity; }
+private:
+    GpuSessionRecord* device = nullptr;
+    std::uint64_t capacity = 0;
+};
+
+#if defined(ROULETTE_CUDA)
+bool gpuAvailable();                      // a CUDA device is present and usable
+// Play sessions [firstStream, firstStream + count) of masterSeed into out[0, count), through `device`
+// (count <= device.size()); throws std::runtime_error on CUDA errors
+void gpuPlaySessions(const StrategyParams& params, WheelKind wheel, std::uint64_t masterSeed, std::uint64_t firstStream, std::uint64_t count,
+    GpuResultBuffer& device, GpuSessionRecord* out);
+#else
+inline bool gpuAvailable() { return false; }
+inline GpuResultBuffer::GpuResultBuffer(std::uint64_t) {
+    throw std::runtime_error("This build has no GPU backend (compile GpuEngine.cu with ROULETTE_CUDA defined)");
+}
+inline GpuResultBuffer::~GpuResultBuffer() = default;
+inline void gpuPlaySessions(const StrategyParams&, WheelKind, std::uint64_t, std::uint64_t, std::uint64_t, GpuResultBuffer&, GpuSessionRecord*) {
+    throw std::runtime_error("This build has no GPU backend (compile GpuEngine.cu with ROULETTE_CUDA defined)");
+}
+#endif
+
+// ============================================================================
+//  GpuEngine
+//  opt.generator, opt.stepping and opt.threads do not apply (always Philox,
+//  one thread per session); traced sessions are left to the CPU engine.
+// ============================================================================
+class GpuEngine { // Headless batch engine on the GPU
+public:
+    explicit GpuEngine(StrategyConfig cfg) : params(makeStrategyParams(cfg)), wheel(cfg.wheel) { requireBuiltInRules(cfg, "The GPU engine"); }
+
+    BatchResult run(const BatchOptions& opt) const {
+        BatchResult out;
+        out.sessions = opt.sessions;
+        if (opt.sessions == 0) return out;
+        std::vector<GpuSessionRecord> records(static_cast<std::size_t>(std::min<std::uint64_t>(opt.sessions, launchSessions)));
+        GpuResultBuffer device(records.size()); // one allocation for every launch
+        TelemetrySlot* slot = opt.telemetry ? &opt.telemetry->slot(0) : nullptr;
+        double chunkSum = 0.0, chunkSquares = 0.0; // the CPU engine's per-chunk sums, in session order
+        std::uint64_t inChunk = 0;
+
+        for (std::uint64_t done = 0; done < opt.sessions; ) {
+            const std::uint64_t n = std::min<std::uint64_t>(opt.sessions - done, launchSessions);
+            gpuPlaySessions(params, wheel, opt.masterSeed, opt.firstSession + done, n, device, records.data());
+            std::uint64_t spins = 0, ruined = 0;
+            for (std::uint64_t i = 0; i < n; ++i) {
+                const GpuSessionRecord& g = records[static_cast<std::size_t>(i)];
+                SessionResult r;
+                r.finalBankroll = g.finalBankroll; r.spins = g.spins; r.maxBetHits = g.maxBetHits;
+                r.longestLossStreak = g.longestLossStreak; r.ruined = g.ruined != 0;
+                out.distribution.add(r);
+                out.ruined += r.ruined ? 1 : 0;
+                out.maxBetHits += static_cast<std::uint64_t>(r.maxBetHits);
+                out.sessionsHittingMaxBet += r.maxBetHits > 0 ? 1 : 0;
+                spins += static_cast<std::uint64_t>(r.spins); ruined += r.ruined ? 1 : 0;
+                chunkSum += r.finalBankroll; chunkSquares += r.finalBankroll * r.finalBankroll;
+                if (++inChunk == SimulationEngine::chunkSize) {
+                    out.finalSum += chunkSum; out.finalSumSq += chunkSquares;
+                    chunkSum = chunkSquares = 0.0; inChunk = 0;
+                }
+            }
+            out.totalSpins += spins;
+            if (slot) slot->addSessions(n, spins, ruined);
+            done += n;
+        }
+        if (inChunk) { out.finalSum += chunkSum; out.finalSumSq += chunkSquares; }
+        finishBatchResult(out);
+        return out;
+    }
+
+private:
+    static constexpr std::uint64_t launchSessions = 1 << 20; // sessions per kernel launch (24 MB of results)
+
+    StrategyParams params;
+    WheelKind wheel;
+};
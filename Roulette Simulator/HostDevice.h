@@ -0,0 +1,13 @@
+// ============================================================================
+//  HostDevice.h - ROULETTE_HOST_DEVICE marks the functions a GPU session
+//  kernel calls (strategy step, Philox, bounded draws) so nvcc compiles them
+//  for both sides; in an ordinary C++ build it expands to nothing
+//  Build:  C++20, Visual Studio 2022 (x64, Windows)
+// ============================================================================
+#pragma once
+
+#if defined(__CUDACC__)
+#define ROULETTE_HOST_DEVICE __host__ __device__
+#else
+#define ROULETTE_HOST_DEVICE
+#endif
@@ -0,0 +1,709 @@
+// ============================================================================
+//  JobRunner.h - runs without prompts, for scripts and job schedulers. Every
+//  setting comes from config files (a TOML subset: key = value, [section]
+//  headers, # comments, strings, booleans, numbers and arrays) and then from
+//  key=value arguments, which override them; the result goes to stdout as one
+//  JSON object, CSV rows, or the interactive text report. Nothing here
+//  touches the console or spawns a process, and an unknown or malformed
+//  setting is an error rather than a silent default.
+//  Build:  C++20, Visual Studio 2022 (x64, Windows)
+// ============================================================================
+#pragma once
+
+#include "BetLayout.h"
+#include "Checkpoint.h"
+#include "DistributedSweep.h"
+#include "ImportanceSampler.h"
+#include "MarkovEvaluator.h"
+#include "PrecisionRunner.h"
+#include "RandomGenerators.h"
+#include "RouletteCore.h"
+#include "SimulationEngine.h"
+#include "SpinLog.h"
+#include "StrategyKernel.h"
+#include "StrategyProgram.h"
+#include "SweepRunner.h"
+#include "Telemetry.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <initializer_list>
+#include <optional>
+#include <ostream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+enum class JobMode { BATCH, PRECISION, EXACT, SWEEP, IMPORTANCE, RECORD, REPLAY };
+enum class OutputFormat { JSON, CSV, TEXT };
+
+struct JobSettings { // One scripted run; see applyJobSetting() for the keys
+    JobMode mode = JobMode::BATCH;
+    OutputFormat format = OutputFormat::JSON;
+    StrategyConfig config;                // the strategy; a sweep varies some of it
+    std::string programName;              // preset or file behind config.program, for the report
+    BatchOptions batch;                   // sessions, seed, threads, generator, stepping, accounting, traces
+    bool stageTiming = false;             // report cycles per stage (scalar stepping only)
+    bool progress = false;                // status line on stderr while running
+    std::string checkpointPath;           // batch and local sweep: save there, resume from it
+    std::uint16_t coordinatorPort = 0;    // sweep: hand shards to --sweep-worker processes
+    PrecisionTarget precision;
+    std::vector<int> sweepThresholds;     // each sweep list left empty takes the strategy's value
+    std::vector<std::vector<double>> sweepLossSets, sweepWinSets;
+    std::vector<double> sweepInitialBets, sweepMaxBets;
+    SweepOptions sweep;                   // maxSessions, seed and threads come from batch
+    double tiltGreen = 0.0, tiltBetColor = 0.0; // importance proposal; 0 = the real wheel's odds
+    int capRunLength = 3, lossStreakLength = 10;
+    EvaluatorOptions exact;
+    std::string spinLogPath;              // record: the log to write; replay: the log to play back
+    std::uint64_t logSpins = 0;           // record: pockets to write from stream (seed, first_session)
+    std::set<std::string> given;          // keys applied, without their section; the run rejects the ones its mode ignores
+};
+
+// ----------------------------------------------------------------------------
+//  Values. Arguments and config files reach applyJobSetting() in the same
+//  text form: lists are separated by spaces or commas, and list sets (the
+//  sweep's multiplier sets) by ';', so "sweep.win_sets=; 1 2" and
+//  win_sets = [[], [1, 2]] mean the same.
+// ----------------------------------------------------------------------------
+namespace job_detail {
+
+[[noreturn]] inline void badValue(const std::string& key, const std::string& value, const char* expected) {
+    throw std::invalid_argument(key + " = \"" + value + "\": expected " + expected);
+}
+
+template<class T>
+T number(const std::string& key, const std::string& value) { // The whole value, or throws
+    T v{};
+    const char* end = value.data() + value.size();
+    const auto [at, e] = std::from_chars(value.data(), end, v);
+    if (e != std::errc() || at != end) badValue(key, value, "a number");
+    if constexpr (std::is_floating_point_v<T>) if (!std::isfinite(v)) badValue(key, value, "a finite number");
+    return v;
+}
+
+inline double positive(const std::string& key, const std::string& value) {
+    const double v = number<double>(key, value);
+    if (!(v > 0)) badValue(key, value, "a positive number");
+    return v;
+}
+
+inline bool flag(const std::string& key, const std::string& value) {
+    if (value == "true" || value == "yes" || value == "on" || value == "1") return true;
+    if (value == "false" || value == "no" || value == "off" || value == "0") return false;
+    badValue(key, value, "true or false");
+}
+
+template<class T>
+std::vector<T> list(const std::string& key, std::string value) { // "3 3 2" or "3, 3, 2"; may be empty
+    for (char& c : value) if (c == ',') c = ' ';
+    std::istringstream in(value);
+    std::vector<T> out;
+    for (std::string w; in >> w; ) out.push_back(number<T>(key, w));
+    return out;
+}
+
+inline std::vector<std::vector<double>> listSets(const std::string& key, const std::string& value) { // "3 3 2; 2 2 2"
+    std::vector<std::vector<double>> out;
+    std::istringstream in(value);
+    for (std::string item; std::getline(in, item, ';'); ) out.push_back(list<double>(key, item));
+    if (!value.empty() && value.back() == ';') out.emplace_back(); // "1 2;" ends with an empty set
+    return out;
+}
+
+template<class E, std::size_t N>
+E choice(const std::string& key, const std::string& value, const std::pair<const char*, E> (&names)[N], const char* expected) {
+    for (const auto& [name, e] : names) if (value == name) return e;
+    badValue(key, value, expected);
+}
+
+inline std::string loadProgram(const std::string& key, const std::string& name) { // A preset, or the source in a file
+    std::string source = presetStrategySource(name);
+    if (source.empty()) {
+        std::ifstream in(name);
+        if (!in) badValue(key, name, "martingale, fibonacci, dalembert, labouchere or a program file");
+        std::ostringstream text; text << in.rdbuf();
+        source = text.str();
+    }
+    (void)StrategyProgram::compile(source); // throws std::invalid_argument with the line at fault
+    return source;
+}
+
+} // namespace job_detail
+
+// Set one key; throws std::invalid_argument for an unknown key or a value it cannot take.
+// Strategy and run keys may also be written as strategy.KEY and run.KEY.
+inline void applyJobSetting(JobSettings& s, std::string key, const std::string& value) {
+    using namespace job_detail;
+    for (const char* section : { "strategy.", "run." })
+        if (key.rfind(section, 0) == 0) key.erase(0, std::char_traits<char>::length(section));
+    StrategyConfig& c = s.config;
+    BatchOptions& b = s.batch;
+
+    if (key == "mode") s.mode = choice(key, value, { std::pair{ "batch", JobMode::BATCH }, { "precision", JobMode::PRECISION },
+        { "exact", JobMode::EXACT }, { "sweep", JobMode::SWEEP }, { "importance", JobMode::IMPORTANCE },
+        { "record", JobMode::RECORD }, { "replay", JobMode::REPLAY } }, "batch, precision, exact, sweep, importance, record or replay");
+    else if (key == "format") s.format = choice(key, value, { std::pair{ "json", OutputFormat::JSON }, { "csv", OutputFormat::CSV },
+        { "text", OutputFormat::TEXT } }, "json, csv or text");
+    else if (key == "progress") s.progress = flag(key, value);
+    else if (key == "checkpoint") s.checkpointPath = value;
+    else if (key == "coordinator") s.coordinatorPort = number<std::uint16_t>(key, value);
+    // Strategy
+    else if (key == "bankroll") c.bankroll = positive(key, value);
+    else if (key == "threshold") { c.lossThreshold = number<int>(key, value); if (c.lossThreshold < 1) badValue(key, value, "at least 1"); }
+    else if (key == "loss") c.lossMultipliers = list<double>(key, value);
+    else if (key == "win") c.winMultipliers = list<double>(key, value);
+    else if (key == "initial_bet") c.initialBet = positive(key, value);
+    else if (key == "max_bet") c.maxBet = positive(key, value);
+    else if (key == "extra") c.extraBet = flag(key, value);
+    else if (key == "side_bets") c.sideBets = BetLayout::parse(value);
+    else if (key == "wheel") c.wheel = choice(key, value, { std::pair{ "european", WheelKind::EUROPEAN }, { "american", WheelKind::AMERICAN },
+        { "triple", WheelKind::TRIPLE_ZERO } }, "european, american or triple");
+    else if (key == "program") { c.program = value.empty() ? "" : loadProgram(key, value); s.programName = value; }
+    // Run
+    else if (key == "sessions") b.sessions = number<std::uint64_t>(key, value);
+    else if (key == "seed") b.masterSeed = number<std::uint64_t>(key, value);
+    else if (key == "first_session") b.firstSession = number<std::uint64_t>(key, value);
+    else if (key == "threads") b.threads = number<unsigned>(key, value);
+    else if (key == "generator") b.generator = choice(key, value, { std::pair{ "xoshiro256pp", GeneratorKind::XOSHIRO256PP },
+        { "xoshiro256x8", GeneratorKind::XOSHIRO256X8 }, { "philox", GeneratorKind::PHILOX4X32 }, { "mt19937", GeneratorKind::MT19937 } },
+        "xoshiro256pp, xoshiro256x8, philox or mt19937");
+    else if (key == "stepping") b.stepping = choice(key, value, { std::pair{ "lanes", SteppingMode::LANES }, { "scalar", SteppingMode::SCALAR } }, "lanes or scalar");
+    else if (key == "accounting") b.accounting = choice(key, value, { std::pair{ "dollars", Accounting::DOLLARS }, { "cents", Accounting::CENTS } }, "dollars or cents");
+    else if (key == "trace") b.traceSessions = list<std::uint64_t>(key, value);
+    else if (key == "trace_file") b.tracePath = value;
+    else if (key == "stage_timing") s.stageTiming = flag(key, value);
+    // Precision target (mode = precision)
+    else if (key == "precision.ruin_half_width") s.precision.ruinHalfWidth = number<double>(key, value);
+    else if (key == "precision.mean_relative_error") s.precision.meanRelativeError = number<double>(key, value);
+    else if (key == "precision.z") s.precision.z = positive(key, value);
+    else if (key == "precision.first_round") s.precision.firstRound = number<std::uint64_t>(key, value);
+    else if (key == "precision.max_sessions") s.precision.maxSessions = number<std::uint64_t>(key, value);
+    // Sweep grid and pruning (mode = sweep; sessions is the per-configuration budget)
+    else if (key == "sweep.thresholds") s.sweepThresholds = list<int>(key, value);
+    else if (key == "sweep.loss_sets") s.sweepLossSets = listSets(key, value);
+    else if (key == "sweep.win_sets") s.sweepWinSets = listSets(key, value);
+    else if (key == "sweep.initial_bets") s.sweepInitialBets = list<double>(key, value);
+    else if (key == "sweep.max_bets") s.sweepMaxBets = list<double>(key, value);
+    else if (key == "sweep.first_round") s.sweep.firstRound = number<std::uint64_t>(key, value);
+    else if (key == "sweep.z") s.sweep.z = positive(key, value);
+    else if (key == "sweep.halving") s.sweep.halving = flag(key, value);
+    // Importance proposal (mode = importance)
+    else if (key == "importance.green") s.tiltGreen = positive(key, value);
+    else if (key == "importance.bet_color") s.tiltBetColor = positive(key, value);
+    else if (key == "importance.cap_run") { s.capRunLength = number<int>(key, value); if (s.capRunLength < 1) badValue(key, value, "at least 1"); }
+    else if (key == "importance.loss_streak") { s.lossStreakLength = number<int>(key, value); if (s.lossStreakLength < 1) badValue(key, value, "at least 1"); }
+    // Exact evaluation (mode = exact)
+    else if (key == "exact.prune_below") { s.exact.pruneBelow = number<double>(key, value); if (s.exact.pruneBelow < 0) badValue(key, value, "at least 0"); }
+    else if (key == "exact.resolution") { s.exact.bankrollResolution = number<double>(key, value); if (s.exact.bankrollResolution < 0) badValue(key, value, "at least 0"); }
+    // Spin logs (mode = record or replay)
+    else if (key == "spin_log") s.spinLogPath = value;
+    else if (key == "log_spins") s.logSpins = number<std::uint64_t>(key, value);
+    else throw std::invalid_argument("Unknown setting: " + key);
+    s.given.insert(key);
+}
+
+// ----------------------------------------------------------------------------
+//  Config files. Keys under [section] get "section." in front; values are
+//  TOML strings ("..." with \ escapes, or '...'), bare numbers and booleans,
+//  and arrays, which may span lines: loss = [3, 3, 2].
+// ----------------------------------------------------------------------------
+namespace job_detail {
+
+class TomlValue { // One value, turned into applyJobSetting()'s text form
+public:
+    explicit TomlValue(const std::string& text) : s(text) {}
+
+    std::string parse() {
+        std::string v = value();
+        skipSpace();
+        if (i < s.size() && s[i] != '#') throw std::invalid_argument("unexpected text after the value");
+        return v;
+    }
+
+private:
+    std::string value() {
+        skipSpace();
+        if (i >= s.size()) throw std::invalid_argument("missing value");
+        if (s[i] == '"' || s[i] == '\'') return quoted();
+        if (s[i] == '[') return array();
+        const std::size_t start = i;
+        while (i < s.size() && s[i] != ',' && s[i] != ']' && s[i] != '#' && s[i] != ' ' && s[i] != '\t') ++i;
+        return s.substr(start, i - start);
+    }
+    std::string quoted() {
+        const char quote = s[i++];
+        std::string out;
+        for (; i < s.size() && s[i] != quote; ++i) {
+            if (quote == '"' && s[i] == '\\' && i + 1 < s.size()) {
+                const char e = s[++i];
+                out += e == 'n' ? '\n' : e == 't' ? '\t' : e;
+            }
+            else out += s[i];
+        }
+        if (i++ >= s.size()) throw std::invalid_argument("unterminated string");
+        return out;
+    }
+    std::string array() { // [1, 2] -> "1 2"; [[3, 3, 2], []] -> "3 3 2;"
+        ++i;
+        std::vector<std::string> items;
+        bool nested = false;
+        for (;;) {
+            skipSpace();
+            if (i >= s.size()) throw std::invalid_argument("unterminated array");
+            if (s[i] == ']') { ++i; break; }
+            nested = nested || s[i] == '[';
+            items.push_back(value());
+            skipSpace();
+            if (i < s.size() && s[i] == ',') ++i;
+        }
+        std::string out;
+        for (std::size_t k = 0; k < items.size(); ++k) out += (k ? (nested ? ";" : " ") : "") + items[k];
+        if (nested && items.size() == 1) out += ";"; // keep a one-set list a set
+        return out;
+    }
+    void skipSpace() { while (i < s.size() && (s[i] == ' ' || s[i] == '\t' || s[i] == '\n' || s[i] == '\r')) ++i; }
+
+    const std::string& s;
+    std::size_t i = 0;
+};
+
+inline int bracketDepth(const std::string& text) { // Unclosed '[' outside strings
+    int depth = 0;
+    char quote = 0;
+    for (std::size_t k = 0; k < text.size(); ++k) {
+        const char ch = text[k];
+        if (quote) { if (ch == '\\' && quote == '"') ++k; else if (ch == quote) quote = 0; }
+        else if (ch == '"' || ch == '\'') quote = ch;
+        else if (ch == '#') break;
+        else if (ch == '[') ++depth;
+        else if (ch == ']') --depth;
+    }
+    return depth;
+}
+
+} // namespace job_detail
+
+inline void readJobFile(const std::string& path, JobSettings& s) { // Throws std::invalid_argument naming the file and line
+    std::ifstream in(path);
+    if (!in) throw std::invalid_argument("Cannot read config file " + path);
+    std::string section, line;
+    for (int number = 1, first = 1; std::getline(in, line); first = ++number) {
+        try {
+            const std::size_t start = line.find_first_not_of(" \t\r");
+            if (start == std::string::npos || line[start] == '#') continue;
+            if (line[start] == '[') {
+                const std::size_t end = line.find(']', start);
+                if (end == std::string::npos) throw std::invalid_argument("unterminated section header");
+                section = line.substr(start + 1, end - start - 1);
+                continue;
+            }
+            const std::size_t eq = line.find('=', start);
+            if (eq == std::string::npos) throw std::invalid_argument("expected key = value");
+            std::string key = line.substr(start, eq - start);
+            key.erase(key.find_last_not_of(" \t") + 1);
+            std::string text = line.substr(eq + 1);
+            while (job_detail::bracketDepth(text) > 0 && std::getline(in, line)) { text += "\n" + line; ++number; } // arrays over several lines
+            applyJobSetting(s, section.empty() ? key : section + "." + key, job_detail::TomlValue(text).parse());
+        }
+        catch (const std::invalid_argument& e) {
+            throw std::invalid_argument(path + ":" + std::to_string(first) + ": " + e.what());
+        }
+    }
+}
+
+// ============================================================================
+//  JobReport - named values in order, written as JSON or CSV. Sweeps add one
+//  row per configuration; text is the interactive report of the same result.
+// ============================================================================
+class JobFields { // Ordered name/value pairs of one record
+public:
+    struct Field { std::string name, value; bool isText; };
+
+    JobFields& text(const std::string& name, const std::string& v) { fields.push_back({ name, v, true }); return *this; }
+    JobFields& count(const std::string& name, std::uint64_t v) { fields.push_back({ name, std::to_string(v), false }); return *this; }
+    JobFields& flag(const std::string& name, bool v) { fields.push_back({ name, v ? "true" : "false", false }); return *this; }
+    JobFields& number(const std::string& name, double v) { // Shortest text that reads back to v; non-finite values are empty
+        char buffer[32];
+        const auto r = std::to_chars(buffer, buffer + sizeof buffer, v);
+        fields.push_back({ name, std::isfinite(v) ? std::string(buffer, r.ptr) : "", false });
+        return *this;
+    }
+    const std::vector<Field>& all() const { return fields; }
+
+private:
+    std::vector<Field> fields;
+};
+
+struct JobReport {
+    JobFields summary;
+    std::vector<JobFields> rows;          // sweep entries, best first
+    std::string text;                     // the print*Result() report
+};
+
+namespace job_detail {
+
+inline void jsonString(const std::string& s, std::ostream& os) {
+    os << '"';
+    for (const char ch : s) {
+        const auto u = static_cast<unsigned char>(ch);
+        if (ch == '"' || ch == '\\') os << '\\' << ch;
+        else if (ch == '\n') os << "\\n";
+        else if (u < 0x20) { const char* hex = "0123456789abcdef"; os << "\\u00" << hex[u >> 4] << hex[u & 15]; }
+        else os << ch;
+    }
+    os << '"';
+}
+
+inline void jsonObject(const JobFields& f, std::ostream& os, const char* tail = "}") { // tail lets the caller add members
+    os << '{';
+    bool first = true;
+    for (const JobFields::Field& x : f.all()) {
+        if (!first) os << ',';
+        first = false;
+        jsonString(x.name, os);
+        os << ':';
+        if (x.isText) jsonString(x.value, os);
+        else os << (x.value.empty() ? "null" : x.value);
+    }
+    os << tail;
+}
+
+inline void csvCell(const std::string& s, std::ostream& os) {
+    if (s.find_first_of(",\"\n") == std::string::npos) { os << s; return; }
+    os << '"';
+    for (const char ch : s) os << (ch == '"' ? "\"\"" : std::string(1, ch));
+    os << '"';
+}
+
+inline void csvRecord(const JobFields& f, bool names, std::ostream& os) {
+    bool first = true;
+    for (const JobFields::Field& x : f.all()) {
+        if (!first) os << ',';
+        first = false;
+        csvCell(names ? x.name : x.value, os);
+    }
+    os << "\n";
+}
+
+} // namespace job_detail
+
+// JSON: one object on one line, with the rows under "entries". CSV: a header and one line per
+// row, or the summary as the single row when there are none.
+inline void writeJobReport(const JobReport& r, OutputFormat format, std::ostream& os) {
+    using namespace job_detail;
+    if (format == OutputFormat::TEXT) { os << r.text; return; }
+    if (format == OutputFormat::JSON) {
+        jsonObject(r.summary, os, "");
+        if (!r.rows.empty()) {
+            os << ",\"entries\":[";
+            for (std::size_t k = 0; k < r.rows.size(); ++k) { if (k) os << ','; jsonObject(r.rows[k], os); }
+            os << ']';
+        }
+        os << "}\n";
+        return;
+    }
+    const std::vector<JobFields> one{ r.summary };
+    const std::vector<JobFields>& records = r.rows.empty() ? one : r.rows;
+    csvRecord(records.front(), true, os);
+    for (const JobFields& f : records) csvRecord(f, false, os);
+}
+
+// ============================================================================
+//  JobRunner
+//  A seed of 0 draws a random one, which the report names so the run can be
+//  repeated. A setting the mode does not read, or a checkpoint file that
+//  does not fit, is an error here, where the interactive path warns and runs
+//  without the checkpoint.
+// ============================================================================
+class JobRunner { // One scripted run
+public:
+    explicit JobRunner(JobSettings settings, std::ostream* status = nullptr) : s(std::move(settings)), log(status) {}
+
+    JobReport run() {
+        const bool seeded = s.mode != JobMode::EXACT && s.mode != JobMode::REPLAY; // a replay's seed is in the log
+        if (s.batch.masterSeed == 0 && seeded) s.batch.masterSeed = randomMasterSeed();
+        rejectUnused();
+        if (s.mode != JobMode::RECORD && s.mode != JobMode::SWEEP) requireBetWithinCap(s.config.initialBet, s.config.maxBet); // a sweep checks its grid
+        JobReport r;
+        r.summary.text("mode", modeName());
+        if (seeded) r.summary.count("seed", s.batch.masterSeed);
+        if (s.mode != JobMode::SWEEP && s.mode != JobMode::RECORD) r.summary.text("strategy", describeConfig(s.config));
+        r.summary.text("wheel", wheelName(s.config.wheel));
+        if (!s.programName.empty()) r.summary.text("program", s.programName);
+        switch (s.mode) {
+        case JobMode::BATCH: runBatch(r); break;
+        case JobMode::PRECISION: runPrecision(r); break;
+        case JobMode::EXACT: runExact(r); break;
+        case JobMode::SWEEP: runSweep(r); break;
+        case JobMode::IMPORTANCE: runImportance(r); break;
+        case JobMode::RECORD: runRecord(r); break;
+        case JobMode::REPLAY: runReplay(r); break;
+        }
+        return r;
+    }
+
+private:
+    void runBatch(JobReport& r) {
+        BatchOptions opt = s.batch;
+        requireSessions(opt.sessions);
+        Telemetry telemetry(opt.sessions);
+        telemetry.stageTiming = s.stageTiming;
+        attach(opt, telemetry);
+        std::optional<BatchCheckpoint> checkpoint;
+        if (!s.checkpointPath.empty()) {
+            checkpoint.emplace(s.checkpointPath, s.config, opt);
+            opt.checkpoint = checkpoint->hook();
+        }
+        BatchResult result;
+        {
+            std::optional<ProgressReporter> progress;
+            if (s.progress && log) progress.emplace(telemetry, *log);
+            result = SimulationEngine(s.config).run(opt);
+        }
+        r.summary.text("generator", generatorKindToString(opt.generator));
+        if (checkpoint) {
+            r.summary.count("resumed_sessions", checkpoint->resumedSessions());
+            if (!checkpoint->hook()->saveError.empty()) r.summary.text("checkpoint_error", checkpoint->hook()->saveError);
+        }
+        batchFields(result, r.summary);
+        stageFields(telemetry, r.summary);
+        std::ostringstream text; printBatchResult(result, text); r.text = text.str();
+    }
+
+    void runPrecision(JobReport& r) {
+        BatchOptions opt = s.batch;
+        requireSessions(s.precision.maxSessions, "precision.max_sessions");
+        Telemetry telemetry;
+        telemetry.stageTiming = s.stageTiming;
+        attach(opt, telemetry);
+        PrecisionResult result;
+        {
+            std::optional<ProgressReporter> progress;
+            if (s.progress && log) progress.emplace(telemetry, *log);
+            result = PrecisionRunner(s.config, s.precision).run(opt);
+        }
+        r.summary.text("generator", generatorKindToString(opt.generator));
+        r.summary.count("rounds", static_cast<std::uint64_t>(result.rounds)).flag("converged", result.converged)
+            .number("ruin_low", result.ruinLow).number("ruin_high", result.ruinHigh).number("mean_relative_error", result.meanRelativeError);
+        batchFields(result.batch, r.summary);
+        stageFields(telemetry, r.summary);
+        std::ostringstream text; printPrecisionResult(result, text); r.text = text.str();
+    }
+
+    void runExact(JobReport& r) {
+        const ExactEvaluation e = MarkovEvaluator(s.config, s.exact).evaluate();
+        r.summary.number("ruin_probability", e.ruinProbability).number("mean_final_bankroll", e.meanFinalBankroll)
+            .number("mean_spins", e.meanSpins).number("mean_max_bet_hits", e.meanMaxBetHits)
+            .number("truncated_mass", e.truncatedMass).number("mean_error_bound", e.meanErrorBound)
+            .number("mean_spins_error_bound", e.meanSpinsErrorBound)
+            .count("peak_states", e.peakStates).count("steps", static_cast<std::uint64_t>(e.steps));
+        std::ostringstream text; printExactEvaluation(e, text); r.text = text.str();
+    }
+
+    void runSweep(JobReport& r) {
+        SweepGrid grid;
+        const StrategyConfig& c = s.config;
+        grid.bankroll = c.bankroll; grid.extraBet = c.extraBet; grid.wheel = c.wheel; grid.sideBets = c.sideBets;
+        grid.lossThresholds = s.sweepThresholds.empty() ? std::vector<int>{ c.lossThreshold } : s.sweepThresholds;
+        grid.lossMultiplierSets = s.sweepLossSets.empty() ? std::vector<std::vector<double>>{ c.lossMultipliers } : s.sweepLossSets;
+        grid.winMultiplierSets = s.sweepWinSets.empty() ? std::vector<std::vector<double>>{ c.winMultipliers } : s.sweepWinSets;
+        grid.initialBets = s.sweepInitialBets.empty() ? std::vector<double>{ c.initialBet } : s.sweepInitialBets;
+        grid.maxBets = s.sweepMaxBets.empty() ? std::vector<double>{ c.maxBet } : s.sweepMaxBets;
+        if (!c.program.empty()) throw std::invalid_argument("Sweeps vary the multiplier rules; leave program unset");
+        grid.requireBetsWithinCaps();
+
+        SweepOptions opt = s.sweep;
+        opt.maxSessions = s.batch.sessions; opt.masterSeed = s.batch.masterSeed; opt.generator = s.batch.generator; opt.threads = s.batch.threads;
+        requireSessions(opt.maxSessions);
+        Telemetry telemetry;
+        if (s.progress) opt.telemetry = &telemetry;
+        SweepResult result;
+        std::optional<SweepCheckpoint> checkpoint;
+        {
+            std::optional<ProgressReporter> progress;
+            if (s.progress && log) progress.emplace(telemetry, *log);
+            if (s.coordinatorPort) {
+                DistributedOptions net;
+                net.port = s.coordinatorPort;
+                SweepCoordinator coordinator(opt, net, log);
+                result = coordinator.run(grid);
+                r.summary.count("workers", coordinator.workersSeen()).count("requeued_shards", coordinator.requeuedShards());
+            }
+            else {
+                if (!s.checkpointPath.empty()) { checkpoint.emplace(s.checkpointPath, grid, opt); opt.checkpoint = checkpoint->hook(); }
+                result = SweepRunner(opt).run(grid);
+            }
+        }
+        if (checkpoint) {
+            r.summary.count("resumed_rounds", static_cast<std::uint64_t>(checkpoint->resumed() ? checkpoint->resumedRounds() : 0));
+            if (!checkpoint->hook()->saveError.empty()) r.summary.text("checkpoint_error", checkpoint->hook()->saveError);
+        }
+        r.summary.text("generator", generatorKindToString(opt.generator));
+        r.summary.count("configurations", result.entries.size()).count("rounds", static_cast<std::uint64_t>(result.rounds))
+            .count("total_sessions", result.totalSessions).count("naive_sessions", result.naiveSessions);
+        for (std::size_t k = 0; k < result.entries.size(); ++k) {
+            const SweepEntry& e = result.entries[k];
+            JobFields row;
+            row.count("rank", k + 1).text("strategy", describeConfig(e.config))
+                .count("threshold", static_cast<std::uint64_t>(e.config.lossThreshold))
+                .text("loss", join(e.config.lossMultipliers)).text("win", join(e.config.winMultipliers))
+                .number("initial_bet", e.config.initialBet).number("max_bet", e.config.maxBet)
+                .count("sessions", e.sessions).count("ruined", e.ruined)
+                .number("ruin_probability", e.ruinProbability()).number("mean_final_bankroll", e.meanFinalBankroll())
+                .count("pruned_in_round", static_cast<std::uint64_t>(e.prunedInRound));
+            r.rows.push_back(std::move(row));
+        }
+        std::ostringstream text; printSweepResult(result, text); r.text = text.str();
+    }
+
+    void runImportance(JobReport& r) {
+        BatchOptions opt = s.batch;
+        requireSessions(opt.sessions);
+        ImportanceOptions tilt = untiltedProposal(s.config.wheel);
+        if (s.tiltGreen > 0) tilt.greenProbability = s.tiltGreen;
+        if (s.tiltBetColor > 0) tilt.betColorProbability = s.tiltBetColor;
+        tilt.capRunLength = s.capRunLength; tilt.lossStreakLength = s.lossStreakLength;
+        Telemetry telemetry(opt.sessions);
+        if (s.progress) opt.telemetry = &telemetry;
+        ImportanceResult result;
+        {
+            std::optional<ProgressReporter> progress;
+            if (s.progress && log) progress.emplace(telemetry, *log);
+            result = ImportanceSampler(s.config, tilt).run(opt);
+        }
+        auto estimate = [&](const std::string& name, const WeightedEstimate& e) { r.summary.number(name, e.value).number(name + "_std_err", e.stdErr); };
+        r.summary.number("proposal_green", tilt.greenProbability).number("proposal_bet_color", tilt.betColorProbability)
+            .count("cap_run_length", static_cast<std::uint64_t>(tilt.capRunLength)).count("loss_streak_length", static_cast<std::uint64_t>(tilt.lossStreakLength))
+            .count("sessions", result.sessions).number("effective_sample_size", result.effectiveSampleSize).number("mean_weight", result.meanWeight);
+        estimate("ruin_probability", result.ruin);
+        estimate("mean_final_bankroll", result.finalBankroll);
+        estimate("mean_extra_bet_net", result.extraBetNet);
+        estimate("p_cap_run", result.capRun);
+        estimate("p_loss_streak", result.lossStreak);
+        std::ostringstream text; printImportanceResult(result, tilt, text); r.text = text.str();
+    }
+
+    void runRecord(JobReport& r) {
+        if (s.spinLogPath.empty()) throw std::invalid_argument("mode = record needs spin_log = FILE");
+        if (s.logSpins == 0) throw std::invalid_argument("mode = record needs log_spins = N");
+        const BatchOptions& b = s.batch;
+        const std::uint64_t spins = recordSpinLog(s.spinLogPath, b.generator, b.masterSeed, b.firstSession, s.logSpins, s.config.wheel);
+        const std::uint64_t bytes = sizeof(SpinLogHeader) + (spins + 2) / 3 * sizeof(std::uint16_t);
+        r.summary.text("generator", generatorKindToString(b.generator)).count("stream", b.firstSession)
+            .text("spin_log", s.spinLogPath).count("spins", spins).count("bytes", bytes);
+        std::ostringstream text;
+        text << "Recorded " << spins << " spins of stream " << b.firstSession << " (seed " << b.masterSeed << ", "
+            << generatorKindToString(b.generator) << ") to " << s.spinLogPath << ", " << bytes << " bytes\n";
+        r.text = text.str();
+    }
+
+    // Back-to-back sessions from the log; the first is session `stream` of a batch with the log's seed and generator
+    void runReplay(JobReport& r) {
+        if (s.spinLogPath.empty()) throw std::invalid_argument("mode = replay needs spin_log = FILE");
+        const SpinLogReader log(s.spinLogPath);
+        const SpinLogHeader& h = log.header();
+        const BatchResult result = replayBatch(log, s.config);
+        r.summary.count("log_seed", h.masterSeed).count("log_stream", h.stream)
+            .text("generator", generatorKindToString(static_cast<GeneratorKind>(h.generator))).count("log_spins", h.spins);
+        batchFields(result, r.summary);
+        r.summary.count("unplayed_spins", h.spins - result.totalSpins);
+        std::ostringstream text; printBatchResult(result, text); r.text = text.str();
+    }
+
+    void rejectUnused() const { // Settings the mode would otherwise ignore
+        for (const std::string& key : s.given)
+            if (!(modesReading(key) & modeBit(s.mode))) throw std::invalid_argument(key + " is not used by mode = " + modeName());
+        if (!s.checkpointPath.empty() && s.coordinatorPort) throw std::invalid_argument("A coordinated sweep does not checkpoint; leave checkpoint or coordinator unset");
+        if (!s.batch.traceSessions.empty() && s.batch.tracePath.empty()) throw std::invalid_argument("trace needs trace_file = FILE");
+    }
+    static unsigned modeBit(JobMode m) { return 1u << static_cast<unsigned>(m); }
+    static unsigned modesReading(const std::string& key) { // JobMode bits of the modes that read `key`
+        auto modes = [](std::initializer_list<JobMode> list) { unsigned bits = 0; for (JobMode m : list) bits |= modeBit(m); return bits; };
+        using enum JobMode;
+        const unsigned sampling = modes({ BATCH, PRECISION, SWEEP, IMPORTANCE });
+        if (key == "mode" || key == "format" || key == "wheel") return modes({ BATCH, PRECISION, EXACT, SWEEP, IMPORTANCE, RECORD, REPLAY });
+        if (key.rfind("precision.", 0) == 0) return modes({ PRECISION });
+        if (key.rfind("sweep.", 0) == 0) return modes({ SWEEP });
+        if (key.rfind("importance.", 0) == 0) return modes({ IMPORTANCE });
+        if (key.rfind("exact.", 0) == 0) return modes({ EXACT });
+        if (key == "spin_log") return modes({ RECORD, REPLAY });
+        if (key == "log_spins") return modes({ RECORD });
+        if (key == "sessions") return modes({ BATCH, SWEEP, IMPORTANCE }); // precision stops at precision.max_sessions
+        if (key == "seed") return sampling | modes({ RECORD });
+        if (key == "first_session") return modes({ BATCH, PRECISION, IMPORTANCE, RECORD }); // a sweep numbers its own rounds
+        if (key == "threads" || key == "progress") return sampling;
+        if (key == "generator") return modes({ BATCH, PRECISION, SWEEP, RECORD }); // importance draws from its own tilted wheel
+        if (key == "stepping" || key == "accounting" || key == "stage_timing") return modes({ BATCH, PRECISION });
+        if (key == "trace" || key == "trace_file") return modes({ BATCH });
+        if (key == "checkpoint") return modes({ BATCH, SWEEP });
+        if (key == "coordinator") return modes({ SWEEP });
+        return modes({ BATCH, PRECISION, EXACT, SWEEP, IMPORTANCE, REPLAY }); // the strategy; a recording has none
+    }
+    void attach(BatchOptions& opt, Telemetry& telemetry) const { // Counters only when something reads them
+        if (s.progress || s.stageTiming) opt.telemetry = &telemetry;
+    }
+    void requireSessions(std::uint64_t n, const char* key = "sessions") const {
+        if (n == 0) throw std::invalid_argument(std::string("mode = ") + modeName() + " needs " + key + " = N");
+    }
+    void stageFields(const Telemetry& telemetry, JobFields& f) const {
+        if (!s.stageTiming) return;
+        const TelemetrySnapshot t = telemetry.snapshot();
+        for (std::size_t k = 0; k < stageCount; ++k) f.count(std::string(stageName(static_cast<Stage>(k))) + "_cycles", t.cycles[k]);
+    }
+    static void batchFields(const BatchResult& b, JobFields& f) {
+        f.count("sessions", b.sessions).count("ruined", b.ruined).number("ruin_probability", b.ruinProbability)
+            .number("mean_final_bankroll", b.meanFinalBankroll).number("mean_std_err", b.meanStdErr)
+            .number("p05", b.p05).number("p25", b.p25).number("median", b.median).number("p75", b.p75).number("p95", b.p95)
+            .count("total_spins", b.totalSpins).count("max_bet_hits", b.maxBetHits).count("sessions_hitting_max_bet", b.sessionsHittingMaxBet)
+            .number("longest_loss_streak_p95", b.distribution.longestLossStreak.quantile(0.95));
+    }
+    static std::string join(const std::vector<double>& v) {
+        std::ostringstream os;
+        for (std::size_t k = 0; k < v.size(); ++k) os << (k ? " " : "") << v[k];
+        return os.str();
+    }
+    static const char* wheelName(WheelKind k) {
+        switch (k) { case WheelKind::EUROPEAN: return "european"; case WheelKind::TRIPLE_ZERO: return "triple"; default: return "american"; }
+    }
+    const char* modeName() const {
+        switch (s.mode) {
+        case JobMode::PRECISION: return "precision"; case JobMode::EXACT: return "exact"; case JobMode::SWEEP: return "sweep";
+        case JobMode::IMPORTANCE: return "importance"; case JobMode::RECORD: return "record"; case JobMode::REPLAY: return "replay";
+        default: return "batch";
+        }
+    }
+
+    JobSettings s;
+    std::ostream* log;                    // progress line and coordinator events; stdout stays for the report
+};
+
+// ============================================================================
+//  runJob - files in order, then `settings` (key, value) pairs in order; the
+//  report goes to `out`, everything else to `err`. Exit code 0 on success, 2
+//  for settings that do not make a run, 1 for a run that failed.
+// ============================================================================
+inline int runJob(const std::vector<std::string>& files, const std::vector<std::pair<std::string, std::string>>& settings,
+    std::ostream& out, std::ostream& err) {
+    JobSettings s;
+    try {
+        for (const std::string& f : files) readJobFile(f, s);
+        for (const auto& [key, value] : settings) applyJobSetting(s, key, value);
+    }
+    catch (const std::invalid_argument& e) { err << "Invalid settings: " << e.what() << "\n"; return 2; }
+    try {
+        const OutputFormat format = s.format;
+        writeJobReport(JobRunner(std::move(s), &err).run(), format, out);
+        out.flush();
+    }
+    catch (const std::invalid_argument& e) { err << "Invalid settings: " << e.what() << "\n"; return 2; }
+    catch (const std::exception& e) { err << "Run failed: " << e.what() << "\n"; return 1; }
+    return 0;
+}
@@ -0,0 +1,229 @@
+// ============================================================================
+//  MarkovEvaluator.h - exact evaluation of a strategy without sampling. The
+//  session is a Markov chain over (bankroll, bet, loss streak, win streak);
+//  the probability mass of every reachable state is pushed forward one spin
+//  at a time through stepSession() until it is absorbed by ruin or the 8-hour
+//  limit. States below a mass threshold are dropped and reported as error;
+//  optionally bankrolls are snapped to a grid to bound the state count.
+//  Build:  C++20, Visual Studio 2022 (x64, Windows)
+// ============================================================================
+#pragma once
+
+#include "RouletteCore.h"
+#include "StrategyKernel.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+struct ExactEvaluation { // Distribution summary for one configuration
+    double ruinProbability = 0.0;         // lower bound; the upper bound adds truncatedMass
+    double meanFinalBankroll = 0.0;
+    double meanSpins = 0.0;               // lower bound; the upper bound adds meanSpinsErrorBound
+    double meanMaxBetHits = 0.0;
+    double truncatedMass = 0.0;           // probability dropped by pruning
+    double meanErrorBound = 0.0;          // |true mean - meanFinalBankroll| is at most this
+    double meanSpinsErrorBound = 0.0;     // spins pruned sessions could still have played
+    std::size_t peakStates = 0;           // largest live state set
+    int steps = 0;                        // spins until all mass was absorbed
+};
+
+struct EvaluatorOptions { // Accuracy/speed trade-offs
+    double pruneBelow = 1e-13;            // drop states with less probability than this
+    double bankrollResolution = 0.0;      // 0 = exact bankrolls; > 0 = grid step in dollars (approximate)
+};
+
+// ============================================================================
+//  MarkovEvaluator
+//  Red and black are symmetric, so the bet color is not part of the state:
+//  every state bets black and a color switch only resets the loss streak.
+//  Each spin splits a state by what stepSession() can tell apart: bet color,
+//  other color or green, and within each the side-bet payout. With no side
+//  bets that is three ways - 18/38, 18/38, 2/38 on the American wheel. Side
+//  bets must pay the same spread on red as on black for the symmetry to hold.
+//  With a bankroll grid, an off-grid bankroll is split between its two grid
+//  neighbours in proportion to distance, which keeps the expected bankroll.
+// ============================================================================
+class MarkovEvaluator { // Exact strategy evaluator
+public:
+    explicit MarkovEvaluator(StrategyConfig cfg, EvaluatorOptions opt = {})
+        : params(makeStrategyParams(cfg)), options(opt) {
+        requireBuiltInRules(cfg, "The exact evaluator");
+        const int pockets = wheelPocketCount(cfg.wheel);
+        std::vector<int> counts;
+        for (std::uint8_t cls : { pocketBlack, pocketRed, pocketGreen }) // bet color (always black, see above), other, green
+            for (int n = 0; n < pockets; ++n) {
+                if (!(pocketClassTable[n] & cls)) continue;
+                std::size_t b = 0;
+                while (b < branches.size() && !((pocketClassTable[branches[b].pocket] & cls) && params.side[branches[b].pocket] == params.side[n])) ++b;
+                if (b == branches.size()) { branches.push_back({ static_cast<std::uint8_t>(n), 0.0 }); counts.push_back(0); }
+                ++counts[b];
+            }
+        for (std::size_t b = 0; b < branches.size(); ++b) branches[b].probability = counts[b] / static_cast<double>(pockets);
+
+        std::vector<double> onRed, onBlack;
+        for (int n = 0; n < pockets; ++n) {
+            if (pocketClassTable[n] & pocketRed) onRed.push_back(params.side[n]);
+            if (pocketClassTable[n] & pocketBlack) onBlack.push_back(params.side[n]);
+        }
+        std::sort(onRed.begin(), onRed.end()); std::sort(onBlack.begin(), onBlack.end());
+        if (onRed != onBlack) throw std::invalid_argument("Exact evaluation needs side bets that pay alike on red and black");
+    }
+
+    ExactEvaluation evaluate() const {
+        ExactEvaluation out;
+        StateMap live, next;
+
+        SessionState start = startSession(params);
+        if (!sessionActive(start)) { // could not open: absorbed before the first spin
+            out.ruinProbability = sessionRuined(start) ? 1.0 : 0.0;
+            out.meanFinalBankroll = start.bankroll;
+            return out;
+        }
+        live.add(StateKey{ start.bankroll, start.currentBet, 0, 0 }, 1.0);
+        double hitsMass = 0.0; // sum over spins of P(cap hit on that spin)
+
+        for (int spin = 0; !live.empty(); ++spin) {
+            out.peakStates = std::max(out.peakStates, live.size());
+            next.clear();
+            for (const StateMap::Entry& e : live.entries()) {
+                for (const Branch& b : branches) {
+                    SessionState s = toSession(e.key, spin);
+                    const StepResult step = stepSession(s, params, b.pocket);
+                    const double p = e.mass * b.probability;
+                    if (step.capHit) hitsMass += p;
+                    if (options.bankrollResolution > 0) snap(out, s, p, next);
+                    else settle(out, s, p, next);
+                }
+            }
+            live.swap(next);
+            out.steps = spin + 1;
+        }
+        out.meanMaxBetHits = hitsMass;
+        return out;
+    }
+
+private:
+    struct StateKey {
+        double bankroll, bet;
+        int losses, wins;                 // wins is clamped to the win table length
+        bool operator==(const StateKey&) const = default;
+    };
+
+    // Open-addressing map from state to mass. Entries live in one dense vector and
+    // the index table is reused between spins, so steady-state stepping does not allocate.
+    class StateMap {
+    public:
+        struct Entry { StateKey key; double mass; };
+        void clear() {
+            for (std::uint32_t slot : used) slots[slot] = vacant;
+            items.clear(); used.clear();
+        }
+        void add(const StateKey& k, double mass) {
+            if ((items.size() + 1) * 2 > slots.size()) grow();
+            const std::size_t slot = slotOf(k);
+            if (slots[slot] == vacant) {
+                slots[slot] = static_cast<std::uint32_t>(items.size());
+                items.push_back({ k, mass }); used.push_back(static_cast<std::uint32_t>(slot));
+            }
+            else items[slots[slot]].mass += mass;
+        }
+        const std::vector<Entry>& entries() const { return items; }
+        std::size_t size() const { return items.size(); }
+        bool empty() const { return items.empty(); }
+        void swap(StateMap& o) { slots.swap(o.slots); items.swap(o.items); used.swap(o.used); }
+    private:
+        static constexpr std::uint32_t vacant = 0xFFFFFFFFu;
+        static std::uint64_t hash(const StateKey& k) { // SplitMix64 finalizer over the packed fields
+            std::uint64_t h = std::bit_cast<std::uint64_t>(k.bankroll);
+            h = splitMix64(h) ^ std::bit_cast<std::uint64_t>(k.bet);
+            h = splitMix64(h) ^ (static_cast<std::uint64_t>(k.losses) << 32 | static_cast<std::uint32_t>(k.wins));
+            return splitMix64(h);
+        }
+        std::size_t slotOf(const StateKey& k) const { // Slot holding k, or the empty slot where it belongs
+            const std::size_t mask = slots.size() - 1;
+            std::size_t i = static_cast<std::size_t>(hash(k)) & mask;
+            while (slots[i] != vacant && !(items[slots[i]].key == k)) i = (i + 1) & mask;
+            return i;
+        }
+        void grow() {
+            slots.assign(slots.empty() ? 1024 : slots.size() * 2, vacant);
+            for (std::size_t n = 0; n < items.size(); ++n) {
+                const std::size_t slot = slotOf(items[n].key);
+                slots[slot] = static_cast<std::uint32_t>(n); used[n] = static_cast<std::uint32_t>(slot);
+            }
+        }
+        std::vector<std::uint32_t> slots;
+        std::vector<Entry> items;
+        std::vector<std::uint32_t> used;  // slot of each entry, for a clear() that skips empty slots
+    };
+    struct Branch { std::uint8_t pocket; double probability; };
+
+    SessionState toSession(const StateKey& k, int spin) const {
+        SessionState s;
+        s.bankroll = k.bankroll; s.currentBet = k.bet;
+        s.consecutiveLosses = k.losses; s.consecutiveWins = k.wins;
+        s.nextProfitThresh = params.startingBankroll; // unused: headless play never stops on profit
+        s.spins = spin;
+        return s;
+    }
+    StateKey toKey(const SessionState& s) const {
+        return { s.bankroll, s.currentBet, s.consecutiveLosses, std::min(s.consecutiveWins, params.win.count) };
+    }
+    void settle(ExactEvaluation& out, const SessionState& s, double p, StateMap& next) const { // Absorb, prune or carry
+        if (!sessionActive(s)) absorb(out, s, p);
+        else if (p < options.pruneBelow) prune(out, s, p);
+        else next.add(toKey(s), p);
+    }
+    void snap(ExactEvaluation& out, SessionState s, double p, StateMap& next) const { // Split across the two grid points
+        const double w = options.bankrollResolution;
+        if (!sessionActive(s)) { absorb(out, s, p); return; } // final values stay exact
+        const double lo = std::floor(s.bankroll / w) * w, t = (s.bankroll - lo) / w;
+        if (t == 0.0) { settle(out, s, p, next); return; }
+        SessionState up = s;
+        s.bankroll = lo; up.bankroll = lo + w;
+        settle(out, s, p * (1.0 - t), next);
+        settle(out, up, p * t, next);
+    }
+    static void absorb(ExactEvaluation& out, const SessionState& s, double p) {
+        if (sessionRuined(s)) out.ruinProbability += p;
+        out.meanFinalBankroll += p * s.bankroll;
+        out.meanSpins += p * s.spins;
+    }
+    // Every bet on this wheel loses on average, so the bankroll is a supermartingale and
+    // a dropped state's expected final bankroll lies between the worst ending and its bankroll now;
+    // its session has played s.spins and can play no further than the 8-hour limit
+    void prune(ExactEvaluation& out, const SessionState& s, double p) const {
+        const double worst = params.side.worst; // side bets can overdraw by their stake
+        out.truncatedMass += p;
+        out.meanErrorBound += p * (std::max(s.bankroll, 0.0) - worst);
+        out.meanSpins += p * s.spins;
+        out.meanSpinsErrorBound += p * (sessionSpinLimit - s.spins);
+    }
+
+    StrategyParams params;
+    EvaluatorOptions options;
+    std::vector<Branch> branches;         // bet color, other color, green, split by side-bet payout
+};
+
+inline void printExactEvaluation(const ExactEvaluation& r, std::ostream& os) { // Print exact results
+    os << "\n===== Exact Evaluation =====\n"
+        << "Ruin probability: " << (r.ruinProbability * 100.0) << "%";
+    if (r.truncatedMass > 0) os << " (at most " << ((r.ruinProbability + r.truncatedMass) * 100.0) << "%)";
+    os << "\n"
+        << "Expected final bankroll: $" << r.meanFinalBankroll;
+    if (r.truncatedMass > 0) os << " (error bound $" << r.meanErrorBound << ")";
+    os << "\n"
+        << "Expected max-bet cap hits: " << r.meanMaxBetHits << "\n"
+        << "Expected spins per session: " << r.meanSpins;
+    if (r.truncatedMass > 0) os << " (at most " << (r.meanSpins + r.meanSpinsErrorBound) << ")";
+    os << "\n"
+        << "Truncated probability: " << r.truncatedMass << "\n"
+        << "States: " << r.peakStates << " peak, " << r.steps << " spins\n"
+        << "============================\n";
+}
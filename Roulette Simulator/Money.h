@@ -0,0 +1,53 @@
+// ============================================================================
+//  Money.h - number policies for the strategy kernel. DollarMoney is the
+//  plain double arithmetic the simulator has always used; CentMoney keeps
+//  every amount in integer cents and every bet multiplier in 16.16 fixed
+//  point, so a session's bankroll is exact and bit-identical on any platform.
+//  Build:  C++20, Visual Studio 2022 (x64, Windows)
+// ============================================================================
+#pragma once
+
+#include "HostDevice.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+struct DollarMoney { // Amounts and multipliers as doubles
+    using Amount = double;
+    using Factor = double;
+
+    static Amount fromDollars(double d) { return d; }
+    static double toDollars(Amount a) { return a; }
+    static Factor factor(double m) { return m; }
+    ROULETTE_HOST_DEVICE static Amount scale(Amount a, Factor f) { return a * f; }    // bet * multiplier
+    static void checkRange(Amount, Factor) {}
+};
+
+// ----------------------------------------------------------------------------
+//  CentMoney - scale() rounds half up to the nearest cent. Products are not
+//  checked spin by spin: checkRange() is called once per strategy with the
+//  largest bet and multiplier, and throws if their product could overflow.
+// ----------------------------------------------------------------------------
+struct CentMoney { // Amounts in int64 cents, multipliers in 16.16 fixed point
+    using Amount = std::int64_t;
+    using Factor = std::int64_t;
+    static constexpr int factorBits = 16;
+    static constexpr double maxDollars = 1e13; // leaves headroom for 823 spins of winnings
+
+    static Amount fromDollars(double d) {
+        if (!(std::fabs(d) <= maxDollars)) throw std::out_of_range("Amount too large for integer cents");
+        return static_cast<Amount>(std::llround(d * 100.0));
+    }
+    static double toDollars(Amount a) { return static_cast<double>(a) / 100.0; }
+    static Factor factor(double m) {
+        if (!(m >= 0 && m < 1e6)) throw std::out_of_range("Multiplier out of range for fixed point");
+        return static_cast<Factor>(std::llround(m * (1 << factorBits)));
+    }
+    ROULETTE_HOST_DEVICE static Amount scale(Amount a, Factor f) { return (a * f + (Factor{ 1 } << (factorBits - 1))) >> factorBits; }
+    static void checkRange(Amount largestBet, Factor largestFactor) {
+        if (largestFactor > 0 && largestBet > (std::numeric_limits<Amount>::max() >> 1) / largestFactor)
+            throw std::out_of_range("Bet times multiplier overflows integer cents");
+    }
+};
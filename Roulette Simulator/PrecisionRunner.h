@@ -0,0 +1,100 @@
+// ============================================================================
+//  PrecisionRunner.h - batches that stop at a requested precision instead of
+//  a fixed session count: "ruin probability to +/-0.1% at 95%" or "mean
+//  final bankroll to 0.5% relative standard error". Sessions run in rounds;
+//  after each round the estimates are checked and the next round is sized
+//  from how far the interval still is from the target.
+//  Build:  C++20, Visual Studio 2022 (x64, Windows)
+// ============================================================================
+#pragma once
+
+#include "SimulationEngine.h"
+#include "StatsSketch.h"
+#include "StrategyKernel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+
+struct PrecisionTarget { // Stop once every set target is met (0 = not used)
+    double ruinHalfWidth = 0.001;         // Wilson interval half-width on the ruin probability
+    double meanRelativeError = 0.0;       // standard error of the mean final bankroll / |mean|
+    double z = 1.96;                      // interval width in standard deviations (1.96 = 95%)
+    std::uint64_t firstRound = 16384;     // sessions before the first check
+    std::uint64_t maxSessions = 1000000000; // give up here even if not converged
+};
+
+struct PrecisionResult {
+    BatchResult batch;                    // every session played, merged
+    int rounds = 0;
+    bool converged = false;
+    double ruinLow = 0.0, ruinHigh = 1.0; // final interval on the ruin probability
+    double meanRelativeError = 0.0;
+};
+
+// ============================================================================
+//  PrecisionRunner
+//  Round r plays sessions [done, target) of the stream space, exactly as one
+//  long run would, and checks only between rounds; the stopping point, and so
+//  the result, depends on the seed alone and not on the thread count.
+// ============================================================================
+class PrecisionRunner { // Run until the confidence interval is tight enough
+public:
+    PrecisionRunner(StrategyConfig cfg, PrecisionTarget t) : engine(std::move(cfg)), target(t) {}
+
+    PrecisionResult run(BatchOptions opt) const { // opt.sessions and opt.firstSession are set per round
+        PrecisionResult out;
+        opt.traceSessions.clear();
+        const std::uint64_t base = opt.firstSession;
+        std::uint64_t done = 0, goal = std::min(std::max<std::uint64_t>(target.firstRound, 1), target.maxSessions);
+        while (done < goal) {
+            ++out.rounds;
+            if (opt.telemetry) opt.telemetry->setTarget(goal);
+            opt.firstSession = base + done; opt.sessions = goal - done;
+            mergeBatchResult(out.batch, engine.run(opt));
+            done = goal;
+
+            const double need = evaluate(out);
+            if (out.converged || done >= target.maxSessions) break;
+            const double grown = std::min(8.0 * static_cast<double>(done), std::ceil(need * 1.05)); // at most 8x per round
+            goal = std::min<std::uint64_t>(target.maxSessions,
+                std::max<std::uint64_t>(done + target.firstRound, static_cast<std::uint64_t>(grown)));
+        }
+        return out;
+    }
+
+private:
+    // Fill in the intervals and return the session count the targets call for (1/sqrt(n) scaling)
+    double evaluate(PrecisionResult& r) const {
+        const BatchResult& b = r.batch;
+        const double n = static_cast<double>(b.sessions);
+        double need = n;
+        wilsonInterval(b.ruined, b.sessions, target.z, r.ruinLow, r.ruinHigh);
+        bool met = true;
+        if (target.ruinHalfWidth > 0) {
+            const double half = (r.ruinHigh - r.ruinLow) / 2;
+            if (half > target.ruinHalfWidth) { met = false; need = std::max(need, n * (half / target.ruinHalfWidth) * (half / target.ruinHalfWidth)); }
+        }
+        r.meanRelativeError = b.meanFinalBankroll != 0 ? b.meanStdErr / std::fabs(b.meanFinalBankroll)
+            : (b.meanStdErr > 0 ? std::numeric_limits<double>::infinity() : 0.0);
+        if (target.meanRelativeError > 0 && r.meanRelativeError > target.meanRelativeError) {
+            met = false;
+            const double ratio = r.meanRelativeError / target.meanRelativeError;
+            need = std::max(need, std::isfinite(ratio) ? n * ratio * ratio : 8.0 * n);
+        }
+        r.converged = met;
+        return need;
+    }
+
+    SimulationEngine engine;
+    PrecisionTarget target;
+};
+
+inline void printPrecisionResult(const PrecisionResult& r, std::ostream& os) { // Print the batch plus how it stopped
+    printBatchResult(r.batch, os);
+    os << (r.converged ? "Converged" : "Stopped at the session limit") << " after " << r.rounds << " rounds: ruin probability in ["
+        << (r.ruinLow * 100.0) << "%, " << (r.ruinHigh * 100.0) << "%], relative std. error of the mean "
+        << (r.meanRelativeError * 100.0) << "%\n";
+}
@@ -0,0 +1,139 @@
+// ============================================================================
+//  RandomGenerators.h - seeding helpers and pluggable generator policies for
+//  RouletteWheel (xoshiro256++, Philox4x32-10, std::mt19937 reference)
+//  Build:  C++20, Visual Studio 2022 (x64, Windows)
+// ============================================================================
+#pragma once
+
+// ----- Standard C++ headers -------------------------------------------------
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <string>
+
+// ----- Project headers ------------------------------------------------------
+#include "HostDevice.h"
+
+// ----------------------------------------------------------------------------
+//  Seeding - one master seed, one independent stream per session. Session i of
+//  a run always draws from stream i, so results do not depend on which thread
+//  (or how many threads) played it.
+// ----------------------------------------------------------------------------
+inline std::uint64_t splitMix64(std::uint64_t& state) { // SplitMix64 step
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+inline std::uint64_t deriveStreamSeed(std::uint64_t masterSeed, std::uint64_t stream) { // Per-stream seed
+    std::uint64_t s = masterSeed;
+    std::uint64_t a = splitMix64(s);
+    s = a ^ (stream * 0xD1342543DE82EF95ull);
+    return splitMix64(s);
+}
+inline std::uint64_t randomMasterSeed() { // Fresh seed for unseeded runs
+    std::random_device rd;
+    return (static_cast<std::uint64_t>(rd()) << 32) ^ rd();
+}
+
+// ============================================================================
+//  Generator policies
+//  Each policy provides seed(masterSeed, stream) and next32(). Keep them small:
+//  the session farm holds one live generator per worker (and, with the lane
+//  stepper, one per lane).
+// ============================================================================
+enum class GeneratorKind { XOSHIRO256PP, XOSHIRO256X8, PHILOX4X32, MT19937 };
+
+inline std::string generatorKindToString(GeneratorKind g) { // Convert generator kind to string
+    switch (g) { case GeneratorKind::XOSHIRO256PP: return "xoshiro256++"; case GeneratorKind::XOSHIRO256X8: return "xoshiro256++x8"; case GeneratorKind::PHILOX4X32: return "philox4x32"; case GeneratorKind::MT19937: return "mt19937"; }
+    return "Unknown";
+}
+
+class Xoshiro256PlusPlus { // 32-byte state, default generator
+public:
+    void seed(std::uint64_t masterSeed, std::uint64_t stream) {
+        std::uint64_t sm = deriveStreamSeed(masterSeed, stream);
+        for (auto& w : s) w = splitMix64(sm); // never all-zero
+    }
+    std::uint64_t next64() {
+        const std::uint64_t result = rotl(s[0] + s[3], 23) + s[0];
+        const std::uint64_t t = s[1] << 17;
+        s[2] ^= s[0]; s[3] ^= s[1]; s[1] ^= s[2]; s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+    std::uint32_t next32() { return static_cast<std::uint32_t>(next64() >> 32); } // high bits are strongest
+private:
+    static std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+    std::uint64_t s[4]{};
+};
+
+class Philox4x32 { // Counter-based: key = master seed, counter = (position, stream); also runs on the GPU
+public:
+    ROULETTE_HOST_DEVICE void seed(std::uint64_t masterSeed, std::uint64_t stream) {
+        key[0] = static_cast<std::uint32_t>(masterSeed); key[1] = static_cast<std::uint32_t>(masterSeed >> 32);
+        ctr[0] = 0; ctr[1] = 0;
+        ctr[2] = static_cast<std::uint32_t>(stream); ctr[3] = static_cast<std::uint32_t>(stream >> 32);
+        used = 4;
+    }
+    ROULETTE_HOST_DEVICE std::uint32_t next32() {
+        if (used == 4) { refill(); used = 0; }
+        return out[used++];
+    }
+private:
+    ROULETTE_HOST_DEVICE void refill() { // One Philox4x32-10 block, then bump the 64-bit position counter
+        std::uint32_t c[4] = { ctr[0], ctr[1], ctr[2], ctr[3] };
+        std::uint32_t k0 = key[0], k1 = key[1];
+        for (int r = 0; r < 10; ++r) {
+            const std::uint64_t p0 = static_cast<std::uint64_t>(0xD2511F53u) * c[0];
+            const std::uint64_t p1 = static_cast<std::uint64_t>(0xCD9E8D57u) * c[2];
+            const std::uint32_t n0 = static_cast<std::uint32_t>(p1 >> 32) ^ c[1] ^ k0;
+            const std::uint32_t n2 = static_cast<std::uint32_t>(p0 >> 32) ^ c[3] ^ k1;
+            c[0] = n0; c[1] = static_cast<std::uint32_t>(p1); c[2] = n2; c[3] = static_cast<std::uint32_t>(p0);
+            k0 += 0x9E3779B9u; k1 += 0xBB67AE85u;
+        }
+        for (int i = 0; i < 4; ++i) out[i] = c[i];
+        if (++ctr[0] == 0) ++ctr[1];
+    }
+    std::uint32_t key[2]{}, ctr[4]{}, out[4]{};
+    int used = 4;
+};
+
+class Mt19937Generator { // Reference generator (~2.5 KB of state)
+public:
+    void seed(std::uint64_t masterSeed, std::uint64_t stream) {
+        std::uint64_t s = deriveStreamSeed(masterSeed, stream);
+        std::uint32_t words[8];
+        for (int i = 0; i < 8; i += 2) {
+            std::uint64_t w = splitMix64(s);
+            words[i] = static_cast<std::uint32_t>(w);
+            words[i + 1] = static_cast<std::uint32_t>(w >> 32);
+        }
+        std::seed_seq seq(std::begin(words), std::end(words));
+        rng.seed(seq);
+    }
+    std::uint32_t next32() { return static_cast<std::uint32_t>(rng()); }
+private:
+    std::mt19937 rng;
+};
+
+// ----------------------------------------------------------------------------
+//  boundedRandom - uniform value in [0, range) by Lemire's nearly-divisionless
+//  method: one 32x32->64 multiply, and a modulo only on the rare rejection path.
+//  Unlike std::uniform_int_distribution the mapping is the same on every
+//  standard library, so seeded runs reproduce across platforms.
+// ----------------------------------------------------------------------------
+template<class Generator>
+ROULETTE_HOST_DEVICE inline std::uint32_t boundedRandom(Generator& g, std::uint32_t range) {
+    std::uint64_t m = static_cast<std::uint64_t>(g.next32()) * range;
+    std::uint32_t low = static_cast<std::uint32_t>(m);
+    if (low < range) {
+        const std::uint32_t threshold = (0u - range) % range;
+        while (low < threshold) {
+            m = static_cast<std::uint64_t>(g.next32()) * range;
+            low = static_cast<std::uint32_t>(m);
+        }
+    }
+    return static_cast<std::uint32_t>(m >> 32);
+}
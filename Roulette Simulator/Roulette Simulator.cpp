@@ -5,9 +5,9 @@
 
 // ----- Standard C++ headers -------------------------------------------------
 #include <iostream>
+#include <fstream>
 #include <random>
 #include <chrono>
-#include <deque>
 #include <vector>
 #include <string>
 #include <iomanip>
@@ -15,15 +15,35 @@
 #include <limits>
 #include <sstream>
 #include <thread>
-#include <cmath>          // for std::ceil
+#include <cmath>          // for std::ceil, std::isfinite
 #include <stdexcept>      // for std::runtime_error
 #include <tuple>          // for std::tie
+#include <cstdlib>        // for std::atoi
+#include <optional>
+
+// ----- Project headers ------------------------------------------------------
+#include "RouletteCore.h"
+#include "SimulationEngine.h"
+#include "StrategyKernel.h"
+#include "StatsTracker.h"
+#include "MarkovEvaluator.h"
+#include "SweepRunner.h"
+#include "PrecisionRunner.h"
+#include "ImportanceSampler.h"
+#include "Checkpoint.h"
+#include "DistributedSweep.h"
+#include "StrategyProgram.h"
+#include "JobRunner.h"
 
 // ----- Win32 headers (console window control) -------------------------------
 #ifdef _WIN32
 #include <windows.h>
+#include <conio.h>        // _kbhit / _getch: keys during unattended play
 #undef max
 #undef min
+#else
+#include <termios.h>      // unbuffered keys during unattended play
+#include <unistd.h>
 #endif
 
 // ============================================================================
@@ -31,8 +51,14 @@
 // ============================================================================
 class ConsoleControl { // Console window control class
 public:
+#ifdef _WIN32
+    static constexpr int defaultPosition = CW_USEDEFAULT; // let Windows place the window
+#else
+    static constexpr int defaultPosition = 0;
+#endif
+
     static void setWindowSize(int widthPx, int heightPx,
-        int x = CW_USEDEFAULT, int y = CW_USEDEFAULT)
+        int x = defaultPosition, int y = defaultPosition)
     {
 #ifdef _WIN32 // Windows only
 		HWND   hWnd = ::GetConsoleWindow(); // Get console window handle
@@ -92,113 +118,135 @@ public:
 		(void)widthPx; (void)heightPx; (void)x; (void)y; // No-op for non-Windows
 #endif
     }
-};
-
-// ============================================================================
-//  Enums, Helpers, and Classes (unchanged)
-// ============================================================================
-enum class Color { RED, BLACK, GREEN };
-enum class Parity { ODD, EVEN, NONE };
-enum class PlayMode { MANUAL, AUTOPLAY, CONTINUOUS };
 
-std::string numberToString(int num) { // Convert number to string
-    return (num == 37) ? "00" : std::to_string(num);
-}
-std::string colorToString(Color c) { // Convert color to string
-    switch (c) { case Color::RED: return "Red"; case Color::BLACK: return "Black"; case Color::GREEN: return "Green"; }
-                                return "Unknown";
-}
-std::string parityToString(Parity p) { // Convert parity to string
-    switch (p) { case Parity::ODD: return "Odd"; case Parity::EVEN: return "Even"; case Parity::NONE: return "None"; }
-                                 return "Unknown";
-}
-
-class RandomNumberGenerator { // Random number generator class
-public:
-    RandomNumberGenerator() : rng(std::random_device{}()) {}
-    int getRandomNumber(int min, int max) { std::uniform_int_distribution<int> dist(min, max); return dist(rng); }
-private:
-    std::mt19937 rng;
-};
-
-struct RouletteOutcome { // Roulette outcome structure
-    int number;
-    Color color;
-    Parity parity;
-};
-
-class RouletteWheel { // Roulette wheel class
-public:
-    RouletteWheel() : rng() {}
-    RouletteOutcome spin() {
-        int outcome = rng.getRandomNumber(0, 37);
-        RouletteOutcome res{ outcome, Color::GREEN, Parity::NONE };
-        if (outcome > 0 && outcome < 37) {
-            static const std::vector<int> redNums = { 1,3,5,7,9,12,14,16,18,19,21,23,25,27,30,32,34,36 };
-            res.color = (std::find(redNums.begin(), redNums.end(), outcome) != redNums.end()) ? Color::RED : Color::BLACK;
-            res.parity = (outcome % 2 == 0) ? Parity::EVEN : Parity::ODD;
-        }
-        return res;
+    static void enableVirtualTerminal() { // Let conhost interpret VT cursor sequences
+#ifdef _WIN32 // Windows only; other terminals already do
+#ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+#define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+#endif
+        HANDLE hOut = ::GetStdHandle(STD_OUTPUT_HANDLE);
+        DWORD mode = 0;
+        if (hOut != INVALID_HANDLE_VALUE && ::GetConsoleMode(hOut, &mode))
+            ::SetConsoleMode(hOut, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+#endif
     }
-private:
-    RandomNumberGenerator rng;
-};
 
-class ExtraBetMode { // Extra-bet mode class
-public:
-    explicit ExtraBetMode(bool en = false) : enabled(en) {}
-    bool isEnabled() const { return enabled; }
-    double extraBetAmount() const { return enabled ? 2.0 : 0.0; }
-    double processOutcome(int outcome) const {
-        if (!enabled) return 0.0;
-        return (outcome == 0 || outcome == 37) ? 34.0 : -2.0;
+    static void clearScreen(std::ostream& os = std::cout) { // VT erase and home; replaces spawning "cls"
+        os << "\x1b[2J\x1b[H" << std::flush;
     }
-private:
-    bool enabled;
 };
 
-class BettingStrategy { // Betting strategy class
+// ============================================================================
+//  ConsoleRenderer  composes each frame into one preallocated buffer and
+//  redraws it in place, at most maxFps times per second. Spins between frames
+//  are still simulated and counted; they just are not drawn.
+// ============================================================================
+class ConsoleRenderer { // Throttled in-place console output
 public:
-    explicit BettingStrategy(std::vector<double> m) : multipliers(std::move(m)) {
-        if (multipliers.empty()) multipliers = { 3.0,3.0,2.0 };
+    explicit ConsoleRenderer(double maxFps, std::ostream& os = std::cout)
+        : out(os), interval(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(maxFps > 0 ? 1.0 / maxFps : 0.0))), stream(&buffer)
+    {
+        ConsoleControl::enableVirtualTerminal();
     }
-    double getMultiplier(int n) const {
-        if (n <= static_cast<int>(multipliers.size())) return multipliers[n - 1];
-        return multipliers.back();
+
+    // Draw compose(std::ostream&) as the new frame if the frame interval has passed (or force is set)
+    template<class Compose>
+    bool present(Compose&& compose, bool force = false) {
+        const auto now = std::chrono::steady_clock::now();
+        if (!force && now < nextFrame) return false;
+        nextFrame = now + interval;
+        buffer.clear();
+        stream << "\x1b[H\x1b[J"; // cursor home, clear to end of screen
+        compose(stream);
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        out.flush(); // one write per frame
+        ++frames;
+        return true;
     }
+    std::uint64_t framesDrawn() const { return frames; }
+
 private:
-    std::vector<double> multipliers;
+    class FrameBuffer : public std::streambuf { // Appends into reserved storage; no allocation once warm
+    public:
+        FrameBuffer() { text.reserve(16 * 1024); }
+        void clear() { text.clear(); }
+        const char* data() const { return text.data(); }
+        std::size_t size() const { return text.size(); }
+    protected:
+        int_type overflow(int_type c) override {
+            if (!traits_type::eq_int_type(c, traits_type::eof())) text.push_back(traits_type::to_char_type(c));
+            return traits_type::not_eof(c);
+        }
+        std::streamsize xsputn(const char* s, std::streamsize n) override {
+            text.append(s, static_cast<std::size_t>(n));
+            return n;
+        }
+    private:
+        std::string text;
+    };
+
+    std::ostream& out;
+    std::chrono::steady_clock::duration interval;
+    std::chrono::steady_clock::time_point nextFrame{};
+    FrameBuffer buffer;
+    std::ostream stream;
+    std::uint64_t frames = 0;
 };
 
-class StatsTracker { // Stats tracker class
+// ============================================================================
+//  KeyPoller  keys pressed while a continuous or auto-play run keeps going.
+//  poll() never blocks: Windows peeks at the console input queue, elsewhere
+//  the terminal is switched to unbuffered, unechoed reads for as long as the
+//  poller is active. Redirected input is left alone for the prompts.
+// ============================================================================
+class KeyPoller { // Non-blocking keyboard
 public:
-    void recordWin(double b) { ++wins; ++spins; moneyBet += b; add("Win:  $" + std::to_string(b)); }
-    void recordLoss(double b) { ++loss; ++spins; moneyBet += b; add("Loss: $" + std::to_string(b)); }
-    void addOutcomeToHistory(const RouletteOutcome& o) {
-        if (o.number == 0) ++count0;
-        else if (o.number == 37) ++count00;
-        add("Spin: " + numberToString(o.number) + " (" + colorToString(o.color) + ", " + parityToString(o.parity) + ")");
+    explicit KeyPoller(bool enable) : enabled(enable) { resume(); }
+    ~KeyPoller() { suspend(); }
+    KeyPoller(const KeyPoller&) = delete;
+    KeyPoller& operator=(const KeyPoller&) = delete;
+
+    char poll() { // Next key pressed, or 0; looks at the console at most every 20 ms
+        if (!enabled) return 0;
+        const auto now = std::chrono::steady_clock::now();
+        if (now < nextPoll) return 0;
+        nextPoll = now + std::chrono::milliseconds(20);
+#ifdef _WIN32
+        if (_kbhit()) return static_cast<char>(_getch());
+#else
+        char c = 0;
+        if (raw && read(STDIN_FILENO, &c, 1) == 1) return c;
+#endif
+        return 0;
     }
-	void print(double bankroll, double currBet, int consLoss, Color betColor) const { // Print stats
-        std::cout << "\n===== Stats =====\n"
-            << "Bankroll: $" << bankroll << "\n"
-            << "Current Bet: $" << currBet << "\n"
-            << "Consecutive Losses: " << consLoss << "\n"
-            << "Betting on: " << colorToString(betColor) << "\n"
-            << "Spins: " << spins << " Wins: " << wins << " Losses: " << loss << " Total Bet: $" << moneyBet << "\n"
-            << "Recent (" << history.size() << "):\n";
-        for (const auto& h : history) std::cout << "  " << h << "\n";
-        std::cout << "Greens: " << (count0 + count00) << " (0: " << count0 << ", 00: " << count00 << ")\n"
-            << "=================\n";
+    void suspend() { // Normal line input, for a prompt
+#ifndef _WIN32
+        if (raw) { tcsetattr(STDIN_FILENO, TCSANOW, &saved); raw = false; }
+#endif
+    }
+    void resume() {
+#ifndef _WIN32
+        if (!enabled || raw || !isatty(STDIN_FILENO) || tcgetattr(STDIN_FILENO, &saved) != 0) return;
+        termios keys = saved;
+        keys.c_lflag &= ~static_cast<tcflag_t>(ICANON | ECHO);
+        keys.c_cc[VMIN] = 0; keys.c_cc[VTIME] = 0; // read() returns at once, with or without a key
+        raw = tcsetattr(STDIN_FILENO, TCSANOW, &keys) == 0;
+#endif
     }
+
 private:
-    int wins = 0, loss = 0, spins = 0;
-    double moneyBet = 0;
-    int count0 = 0, count00 = 0;
-    std::deque<std::string> history;
-    void add(const std::string& s) { if (history.size() >= 10) history.pop_front(); history.push_back(s); }
+    bool enabled;
+    std::chrono::steady_clock::time_point nextPoll{};
+#ifndef _WIN32
+    termios saved{};
+    bool raw = false;
+#endif
 };
 
+// ============================================================================
+//  UI class (core game types live in RouletteCore.h, stats in StatsTracker.h)
+// ============================================================================
 class UserInterface { // User interface class
 public:
     template<typename T>
@@ -215,9 +263,13 @@ public:
     double getInitialBankroll() const { return getValidated<double>("Enter your initial bankroll: $"); }
     int getLossThreshold() const { return getValidated<int>("Enter max consecutive losses before switching: "); }
 	std::pair<PlayMode, int> getPlayMode() const { // Get play mode
-        int m = getValidated<int>("Enter play mode (0=manual, -1=continuous, >0=auto spins): ");
+        int m = getValidated<int>("Enter play mode (0=manual, -1=continuous, -2=batch, -3=exact, -4=sweep, -5=importance, >0=auto spins): ");
         if (m == 0) return { PlayMode::MANUAL,0 };
         if (m == -1) return { PlayMode::CONTINUOUS,0 };
+        if (m == -2) return { PlayMode::BATCH,getSessionCount(true) };
+        if (m == -3) return { PlayMode::EXACT,0 };
+        if (m == -4) return { PlayMode::SWEEP,getSessionCount() };
+        if (m == -5) return { PlayMode::IMPORTANCE,getSessionCount() };
         return { PlayMode::AUTOPLAY,m };
     }
 	std::vector<double> getMultipliers(const std::string& prompt, const std::string& emptyMsg) const { // Get multipliers
@@ -227,29 +279,200 @@ public:
         std::vector<double> m; double x;
         while (iss >> x) m.push_back(x);
         if (m.empty()) std::cout << emptyMsg << "\n";
+        if (m.size() > static_cast<std::size_t>(maxStrategyMultipliers)) { // Kernel holds a fixed-size table
+            std::cout << "Only the first " << maxStrategyMultipliers << " multipliers are used.\n";
+            m.resize(maxStrategyMultipliers);
+        }
         return m;
+    }
+	int getSessionCount(bool allowAdaptive = false) const { // Sessions for a headless batch run; 0 = until precise
+        int n = getValidated<int>(allowAdaptive ? "Enter number of sessions to simulate (0 = until a target precision): "
+            : "Enter number of sessions to simulate: ");
+        if (allowAdaptive && n == 0) return 0;
+        return n > 0 ? n : 1;
+    }
+	PrecisionTarget getPrecisionTarget() const { // Stopping rule for an adaptive batch
+        PrecisionTarget t;
+        t.ruinHalfWidth = getValidated<double>("Enter ruin probability precision, +/- % at 95% (e.g. 0.1, 0 = none): ") / 100.0;
+        t.meanRelativeError = getValidated<double>("Enter mean bankroll relative std. error, % (e.g. 0.5, 0 = none): ") / 100.0;
+        if (t.ruinHalfWidth <= 0 && t.meanRelativeError <= 0) t.ruinHalfWidth = 0.001;
+        return t;
+    }
+	ImportanceOptions getImportanceOptions(WheelKind wheel) const { // Tilted wheel for rare-event estimates
+        ImportanceOptions o = untiltedProposal(wheel);
+        std::ostringstream green, hit; // the true wheel's odds, as a hint
+        green << std::setprecision(4) << o.greenProbability * 100.0;
+        hit << std::setprecision(4) << o.betColorProbability * 100.0;
+        const double greenP = getValidated<double>("Enter proposal chance of green, % (true wheel " + green.str() + "): ") / 100.0;
+        const double hitP = getValidated<double>("Enter proposal chance of the bet color, % (true wheel " + hit.str() + "): ") / 100.0;
+        if (greenP > 0 && hitP > 0 && greenP + hitP < 1) { o.greenProbability = greenP; o.betColorProbability = hitP; }
+        else std::cout << "Invalid proposal \x96 using the true wheel.\n";
+        o.capRunLength = std::max(1, getValidated<int>("Enter max-bet cap run length to estimate: "));
+        o.lossStreakLength = std::max(1, getValidated<int>("Enter loss streak length to estimate: "));
+        return o;
+    }
+	std::uint64_t getMasterSeed() const { // Seed for a reproducible batch run
+        return getValidated<std::uint64_t>("Enter master seed (0 = random): ");
+    }
+	std::string getLine(const std::string& prompt) const { // One line of free text
+        std::cout << prompt;
+        std::string line; std::getline(std::cin, line);
+        return line;
+    }
+	std::vector<double> getNumbers(const std::string& prompt) const { // Whitespace-separated list, may be empty
+        std::cout << prompt;
+        std::string line; std::getline(std::cin, line);
+        std::istringstream iss(line);
+        std::vector<double> v; double x;
+        while (iss >> x) v.push_back(x);
+        return v;
+    }
+	std::vector<std::vector<double>> getMultiplierSets(const std::string& prompt) const { // ';'-separated lists, may be empty
+        std::cout << prompt;
+        std::string line; std::getline(std::cin, line);
+        std::vector<std::vector<double>> sets;
+        if (line.find_first_not_of(" \t") == std::string::npos) return sets;
+        std::istringstream all(line);
+        for (std::string part; std::getline(all, part, ';'); ) {
+            std::istringstream iss(part);
+            std::vector<double> m; double x;
+            while (iss >> x) m.push_back(x);
+            if (m.size() > static_cast<std::size_t>(maxStrategyMultipliers)) m.resize(maxStrategyMultipliers);
+            sets.push_back(std::move(m)); // an empty set is a valid choice (defaults)
+        }
+        return sets;
+    }
+	SweepGrid getSweepGrid(const StrategyConfig& base) const { // Sweep ranges; every empty answer keeps the current setting
+        SweepGrid g;
+        g.bankroll = base.bankroll; g.extraBet = base.extraBet; g.wheel = base.wheel; g.sideBets = base.sideBets;
+        g.lossThresholds = { base.lossThreshold };
+        g.lossMultiplierSets = { base.lossMultipliers };
+        g.winMultiplierSets = { base.winMultipliers };
+        g.initialBets = { base.initialBet };
+        g.maxBets = { base.maxBet };
+        auto thresholds = getNumbers("Enter loss thresholds to sweep (e.g. \"2 3 4\", empty = current): ");
+        if (!thresholds.empty()) {
+            g.lossThresholds.clear();
+            for (double t : thresholds) g.lossThresholds.push_back(std::max(1, static_cast<int>(t)));
+        }
+        auto lossSets = getMultiplierSets("Enter loss multiplier sets separated by ';' (e.g. \"3 3 2; 2 2 2\", empty = current): ");
+        if (!lossSets.empty()) g.lossMultiplierSets = lossSets;
+        auto winSets = getMultiplierSets("Enter win multiplier sets separated by ';' (e.g. \"; 1 2\", empty = current): ");
+        if (!winSets.empty()) g.winMultiplierSets = winSets;
+        auto bets = getNumbers("Enter initial bets to sweep (empty = current): ");
+        if (!bets.empty()) g.initialBets = bets;
+        auto caps = getNumbers("Enter max bets to sweep (empty = current): ");
+        if (!caps.empty()) g.maxBets = caps;
+        try { g.requireBetsWithinCaps(); }
+        catch (const std::invalid_argument& e) {
+            std::cout << e.what() << " \x96 sweeping the current bets.\n";
+            g.initialBets = { base.initialBet }; g.maxBets = { base.maxBet };
+        }
+        return g;
+    }
+	WheelKind getWheelKind() const { // Ask for the wheel; empty keeps the American wheel
+        const std::string s = getLine("Choose wheel (1=European 0, 2=American 0/00, 3=triple zero 0/00/000, empty=American): ");
+        if (s == "1") return WheelKind::EUROPEAN;
+        if (s == "3") return WheelKind::TRIPLE_ZERO;
+        return WheelKind::AMERICAN;
+    }
+	BetLayout getSideBets(WheelKind wheel) const { // Chips placed every spin besides the color bet
+        const std::string s = getLine("Enter side bets (e.g. \"straight 17 5; split 8 9 2; dozen 2 10\", empty = none): ");
+        try {
+            BetLayout l = BetLayout::parse(s);
+            (void)compilePayouts(l, wheel); // every pocket must exist on this wheel
+            return l;
+        }
+        catch (const std::invalid_argument& e) {
+            std::cout << "Invalid side bets (" << e.what() << ") \x96 none placed.\n";
+            return BetLayout();
+        }
+    }
+	std::string getProgram() const { // Strategy program for the headless runs: a preset, a file, or none
+        const std::string s = getLine("Enter strategy program (martingale, fibonacci, dalembert, labouchere or a file name, empty = the multipliers above): ");
+        if (s.empty()) return s;
+        std::string source = presetStrategySource(s);
+        if (source.empty()) {
+            std::ifstream in(s);
+            if (!in) { std::cout << "No such preset or file \x96 using the multipliers.\n"; return ""; }
+            std::ostringstream text; text << in.rdbuf();
+            source = text.str();
+        }
+        try { (void)StrategyProgram::compile(source); }
+        catch (const std::invalid_argument& e) {
+            std::cout << "Invalid strategy program (" << e.what() << ") \x96 using the multipliers.\n";
+            return "";
+        }
+        return source;
+    }
+	ProfitPolicy getProfitPolicy(PlayMode mode) const { // What to do at each profit threshold
+        const bool attended = mode != PlayMode::CONTINUOUS;
+        const std::string s = getLine(std::string("At each profit threshold: a=ask, c=continue, s=stop (empty = ") + (attended ? "ask" : "continue") + "): ");
+        if (s == "c" || s == "C") return ProfitPolicy::CONTINUE;
+        if (s == "s" || s == "S") return ProfitPolicy::STOP;
+        if (s == "a" || s == "A") return ProfitPolicy::ASK;
+        return attended ? ProfitPolicy::ASK : ProfitPolicy::CONTINUE;
+    }
+	int getCapPause() const { // Pause after this many capped bets in a row; 0 = never
+        std::istringstream in(getLine("Pause after how many max-bet hits in a row? (empty = never): "));
+        int n = 0;
+        return (in >> n) && n > 0 ? n : 0;
+    }
+	double getFrameRate() const { // Console redraws per second during play; 0 = every spin
+        std::istringstream in(getLine("Redraws per second while playing? (empty = 30, 0 = every spin): "));
+        double fps = 0.0;
+        return (in >> fps) && fps >= 0 && std::isfinite(fps) ? fps : 30.0;
     }
 	bool askExtraBet() const { // Ask for extra-bet mode
         char c;
-        std::cout << "Enable Extra-Bet mode ($1 on 0 and 00)? (y/n): ";
+        std::cout << "Enable Extra-Bet mode ($1 on each zero)? (y/n): ";
         std::cin >> c; std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
         return (c == 'y' || c == 'Y');
     }
 };
 
-class CasinoTimer { // Casino timer class
-public:
-    void addSpin() { std::this_thread::sleep_for(std::chrono::milliseconds(100)); elapsed += 35; }
-    bool isTimeUp() const { return elapsed >= 8 * 3600; }
-    int seconds() const { return elapsed; }
-private:
-    int elapsed = 0;
-};
-
 // ============================================================================
 //  main()
 // ============================================================================
-int main() { // Main function
+int main(int argc, char** argv) { // Main function
+    std::uint16_t sweepPort = 0; // --sweep-coordinator PORT: sweeps are sent to remote workers
+    std::string checkpointPath; // --checkpoint FILE: batches and sweeps save progress there and resume from it
+    std::vector<std::string> jobFiles; // --config FILE: settings for a run without prompts (JobRunner.h)
+    std::vector<std::pair<std::string, std::string>> jobSettings; // key=value or --key=value, applied after the files
+    bool scripted = false;
+    for (int i = 1; i < argc; ++i) { // Distributed sweep roles
+        const std::string a = argv[i];
+        const std::size_t eq = a.find('=');
+        if (a == "--sweep-coordinator" && i + 1 < argc) { sweepPort = static_cast<std::uint16_t>(std::atoi(argv[i + 1])); jobSettings.emplace_back("coordinator", argv[++i]); }
+        else if (a == "--checkpoint" && i + 1 < argc) { checkpointPath = argv[i + 1]; jobSettings.emplace_back("checkpoint", argv[++i]); }
+        else if (a == "--config" && i + 1 < argc) { jobFiles.push_back(argv[++i]); scripted = true; }
+        else if (eq != std::string::npos && eq > 0 && a.rfind("-", 0) != 0) { jobSettings.emplace_back(a.substr(0, eq), a.substr(eq + 1)); scripted = true; }
+        else if (eq != std::string::npos && a.rfind("--", 0) == 0 && eq > 2) { jobSettings.emplace_back(a.substr(2, eq - 2), a.substr(eq + 1)); scripted = true; }
+        else if (a == "--sweep-worker" && i + 1 < argc) { // --sweep-worker HOST:PORT [--threads N]: serve shards, then exit
+            const std::string target = argv[++i];
+            unsigned threads = 0;
+            if (i + 2 < argc && std::string(argv[i + 1]) == "--threads") { threads = static_cast<unsigned>(std::atoi(argv[i + 2])); i += 2; }
+            const std::size_t colon = target.rfind(':');
+            if (colon == std::string::npos) { std::cerr << "Expected HOST:PORT after --sweep-worker\n"; return 1; }
+            try {
+                const std::uint64_t shards = runSweepWorker(target.substr(0, colon), static_cast<std::uint16_t>(std::atoi(target.c_str() + colon + 1)), threads, std::cout);
+                std::cout << "Coordinator finished; " << shards << " shards completed here.\n";
+                return 0;
+            }
+            catch (const std::exception& ex) { std::cerr << "[Worker stopped] " << ex.what() << "\n"; return 1; }
+        }
+        else {
+            std::cerr << "Usage: " << argv[0] << " [--checkpoint FILE] [--sweep-coordinator PORT | --sweep-worker HOST:PORT [--threads N]]\n"
+                << "       " << argv[0] << " [--config FILE]... [key=value]...   (no prompts; report on stdout, see JobRunner.h)\n";
+            return 1;
+        }
+    }
+    if (scripted) { // No prompts, no console setup: settings in, report out
+        std::ios::sync_with_stdio(false);
+        return runJob(jobFiles, jobSettings, std::cout, std::cerr);
+    }
+    ConsoleControl::enableVirtualTerminal(); // for clearScreen() and the in-place redraw
+
 	/*
     try { // Resize console window to 1920x1080
         ConsoleControl::setWindowSize(1920, 1080);
@@ -262,9 +485,11 @@ int main() { // Main function
     UserInterface ui;
     bool playAgain = false;
     bool hasExistingBankroll = false;
+    const double initialBet = 100.0; // opening bet
     const double maxBet = 10000.0;  // maximum bet cap
     double bankroll = 0.0, startingBankroll = 0.0;
     int lossThreshold = 0;
+	AnyRouletteWheel wheel; // Roulette wheel, kept across replays; the layout is chosen per game
 
 	do { // Main game loop
         // -- (Re)gather settings
@@ -281,113 +506,237 @@ int main() { // Main function
             "Enter win multipliers (empty = reset to $1): ",
             "No win multipliers  bet resets to $1 after a win.");
 
-		ExtraBetMode extra(ui.askExtraBet()); // Ask for extra-bet mode
+		const WheelKind wheelKind = ui.getWheelKind(); // Ask for the wheel layout
+		ExtraBetMode extra(ui.askExtraBet(), wheelZeros(wheelKind)); // Ask for extra-bet mode
+		const BetLayout sideBets = ui.getSideBets(wheelKind); // Ask for further side bets
 		auto [playMode, autoSpins] = ui.getPlayMode(); // Ask for play mode
 
-		BettingStrategy lossStrat(lossMult); // Loss multipliers
-		BettingStrategy winStrat(winMult); // Win multipliers
-		bool useWinMult = !winMult.empty(); // Use win multipliers
-
-		RouletteWheel wheel; // Roulette wheel
-		StatsTracker stats; // Stats tracker
-		CasinoTimer timer; // Casino timer
-
-		double initialBet = 100.0; // Initial bet amount
-		double currentBet = initialBet; // Current bet amount
-		Color betColor = Color::BLACK; // Initial bet color // Black // Add method to get color from user
-        int consecutiveLosses = 0, consecutiveWins = 0, maxBetHits = 0;
-        double nextProfitThresh = startingBankroll;
-        bool keepPlaying = true;
-
-        // Lambda for one spin
-		auto spinOnce = [&]() -> bool { // Spin once and update bankroll
-			if (playMode == PlayMode::MANUAL) { // Manual play
-                std::cout << "Press <Enter> to spin...";
-                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            }
-			auto spin_result = wheel.spin(); // Spin the wheel
-            std::cout << "\nOutcome: " << numberToString(spin_result.number) 
-                << " (" << colorToString(spin_result.color)
-                << ", " << parityToString(spin_result.parity) << ")\n";
-            stats.addOutcomeToHistory(spin_result); 
-
-            double extraResult = extra.processOutcome(spin_result.number);
-            double totalWager = currentBet + extra.extraBetAmount();
-
-			if (spin_result.color == betColor) { // Win
-                double net_gain = currentBet + extraResult;
-                bankroll += net_gain;
-                stats.recordWin(currentBet);
-                std::cout << "You WIN! Net change: $" << net_gain << "\n";
-                ++consecutiveWins; consecutiveLosses = 0;
-				if (useWinMult) { // Use win multipliers
-                    double newBet = initialBet * winStrat.getMultiplier(consecutiveWins);
-					if (newBet >= maxBet) { newBet = maxBet; ++maxBetHits; } // Cap hit
-                    currentBet = newBet;
+		StrategyConfig config; // Settings shared by both play paths
+        config.bankroll = startingBankroll;
+        config.lossThreshold = lossThreshold;
+        config.lossMultipliers = lossMult;
+        config.winMultipliers = winMult;
+        config.extraBet = extra.isEnabled();
+        config.initialBet = initialBet;
+        config.maxBet = maxBet;
+        config.wheel = wheelKind;
+        config.sideBets = sideBets;
+
+		if (playMode == PlayMode::BATCH && autoSpins == 0) { // Headless batch run until the target precision
+            config.program = ui.getProgram();
+            const PrecisionTarget target = ui.getPrecisionTarget();
+            BatchOptions opt;
+            opt.masterSeed = ui.getMasterSeed();
+            if (opt.masterSeed == 0) opt.masterSeed = randomMasterSeed();
+            std::cout << "Simulating until the target precision (seed " << opt.masterSeed << ")...\n";
+            Telemetry telemetry; // Live progress line; each round sets the target
+            opt.telemetry = &telemetry;
+            ProgressReporter progress(telemetry, std::cout);
+            const PrecisionResult result = PrecisionRunner(config, target).run(opt);
+            progress.stop();
+            printPrecisionResult(result, std::cout);
+        }
+		else if (playMode == PlayMode::BATCH) { // Headless batch run, no per-spin output
+            BatchOptions opt;
+            opt.sessions = static_cast<std::uint64_t>(autoSpins);
+            config.program = ui.getProgram();
+            opt.masterSeed = ui.getMasterSeed();
+            if (opt.masterSeed == 0) opt.masterSeed = randomMasterSeed();
+            if (config.program.empty()) // traces follow the built-in rules
+                for (double s : ui.getNumbers("Enter session indices to trace spin by spin (0-based, empty = none): ")) {
+                    if (s >= 0 && s < static_cast<double>(opt.sessions)) opt.traceSessions.push_back(static_cast<std::uint64_t>(s));
+                    else std::cout << "No session " << s << " in this batch \x96 not traced.\n";
                 }
-				else { // Reset to initial bet
-                    currentBet = initialBet; consecutiveWins = 0;
+            if (!opt.traceSessions.empty()) opt.tracePath = ui.getLine("Enter trace file name: ");
+            std::optional<BatchCheckpoint> checkpoint; // Saved every few seconds; a rerun with the same settings resumes
+            if (!checkpointPath.empty()) {
+                try {
+                    checkpoint.emplace(checkpointPath, config, opt);
+                    opt.checkpoint = checkpoint->hook();
+                    if (checkpoint->resumedSessions()) std::cout << "Resuming from " << checkpointPath << ": " << checkpoint->resumedSessions() << " sessions already played.\n";
                 }
+                catch (const std::runtime_error& e) { std::cout << e.what() << " \x96 running without a checkpoint.\n"; }
             }
-			else { // Lose
-                double net_loss = -currentBet + extraResult;
-                bankroll += net_loss;
-                stats.recordLoss(currentBet);
-                std::cout << "You lose. Net change: $" << net_loss << "\n";
-                ++consecutiveLosses; consecutiveWins = 0;
-                double newBet = currentBet * lossStrat.getMultiplier(consecutiveLosses);
-				if (newBet >= maxBet) { newBet = maxBet; ++maxBetHits; } // Cap hit
-                /* TODO: Add a check if the max beat has repeated back to back consecutivly n times // force game stop and request instructions // stop, continue, manualy change bet */
-                currentBet = newBet;
+            std::cout << "Simulating " << opt.sessions << " sessions (seed " << opt.masterSeed << ")...\n";
+            Telemetry telemetry(opt.sessions); // Live progress line while the batch runs
+            opt.telemetry = &telemetry;
+            ProgressReporter progress(telemetry, std::cout);
+            const BatchResult result = SimulationEngine(config).run(opt);
+            progress.stop();
+            if (checkpoint && !checkpoint->hook()->saveError.empty()) std::cout << "Checkpoint not saved: " << checkpoint->hook()->saveError << "\n";
+            printBatchResult(result, std::cout);
+        }
+		else if (playMode == PlayMode::EXACT) { // Exact Markov-chain evaluation, no sampling
+            std::cout << "Evaluating the strategy exactly...\n";
+            try { printExactEvaluation(MarkovEvaluator(config).evaluate(), std::cout); }
+            catch (const std::invalid_argument& e) { std::cout << e.what() << "\n"; }
+        }
+		else if (playMode == PlayMode::SWEEP) { // Grid of configurations, losers stopped early
+            SweepGrid grid = ui.getSweepGrid(config);
+            SweepOptions opt;
+            opt.maxSessions = static_cast<std::uint64_t>(autoSpins);
+            opt.masterSeed = ui.getMasterSeed();
+            if (opt.masterSeed == 0) opt.masterSeed = randomMasterSeed();
+            std::cout << "Sweeping " << grid.expand().size() << " configurations, up to " << opt.maxSessions
+                << " sessions each (seed " << opt.masterSeed << ")...\n";
+            Telemetry telemetry; // Live progress line; the sweep sets the target each round
+            opt.telemetry = &telemetry;
+            ProgressReporter progress(telemetry, std::cout);
+            SweepResult result;
+            if (sweepPort) { // Shards go to remote workers; start them with --sweep-worker
+                DistributedOptions net;
+                net.port = sweepPort;
+                SweepCoordinator coordinator(opt, net, &std::cerr);
+                result = coordinator.run(grid);
+                progress.stop();
+                std::cout << coordinator.workersSeen() << " workers, " << coordinator.requeuedShards() << " shards re-sent after failures\n";
             }
-			if (consecutiveLosses >= lossThreshold) { // Switch color
-                betColor = (betColor == Color::BLACK) ? Color::RED : Color::BLACK;
-                std::cout << "Reached " << lossThreshold << " losses  switching to "
-                    << colorToString(betColor) << ".\n";
-                consecutiveLosses = 0;
+            else {
+                std::optional<SweepCheckpoint> checkpoint; // Saved after every round
+                if (!checkpointPath.empty()) {
+                    try {
+                        checkpoint.emplace(checkpointPath, grid, opt);
+                        opt.checkpoint = checkpoint->hook();
+                        if (checkpoint->resumed()) std::cout << "Resuming from " << checkpointPath << " after round " << checkpoint->resumedRounds() << ".\n";
+                    }
+                    catch (const std::runtime_error& e) { std::cout << e.what() << " \x96 running without a checkpoint.\n"; }
+                }
+                result = SweepRunner(opt).run(grid);
+                progress.stop();
+                if (checkpoint && !checkpoint->hook()->saveError.empty()) std::cout << "Checkpoint not saved: " << checkpoint->hook()->saveError << "\n";
             }
-            stats.print(bankroll, currentBet, consecutiveLosses, betColor);
-            timer.addSpin();
+            printSweepResult(result, std::cout);
+        }
+		else if (playMode == PlayMode::IMPORTANCE) { // Rare-event estimates from a tilted wheel
+            const ImportanceOptions tilt = ui.getImportanceOptions(config.wheel);
+            BatchOptions opt;
+            opt.sessions = static_cast<std::uint64_t>(autoSpins);
+            opt.masterSeed = ui.getMasterSeed();
+            if (opt.masterSeed == 0) opt.masterSeed = randomMasterSeed();
+            std::cout << "Sampling " << opt.sessions << " sessions from the tilted wheel (seed " << opt.masterSeed << ")...\n";
+            Telemetry telemetry(opt.sessions);
+            opt.telemetry = &telemetry;
+            ProgressReporter progress(telemetry, std::cout);
+            const ImportanceResult result = ImportanceSampler(config, tilt).run(opt);
+            progress.stop();
+            printImportanceResult(result, tilt, std::cout);
+        }
+		else { // Interactive play
+			const StrategyParams params = makeStrategyParams(config); // Betting rules, shared with the engine
+			SessionState session = startSession(params); // Bankroll, bet, streaks and color
+			StatsTracker stats(wheelZeros(config.wheel)); // Stats tracker
+			wheel.select(config.wheel);
+			CasinoTimer timer(std::chrono::milliseconds(playMode == PlayMode::CONTINUOUS ? 0 : 100)); // Presentation delay per spin; continuous runs flat out
+			const ProfitPolicy profitPolicy = ui.getProfitPolicy(playMode); // ask, or run unattended past each threshold
+			const int capPause = ui.getCapPause(); // pause for instructions after a run of capped bets
+			const double frameRate = ui.getFrameRate(); // console redraws per second; spins between frames are not drawn
+			const bool unattended = playMode == PlayMode::CONTINUOUS || playMode == PlayMode::AUTOPLAY;
+			if (unattended) std::cout << "Keys while playing: p = pause, b = change bet, s = stop.\n";
+			KeyPoller keys(unattended); // read between spins, never waited for
+			ConsoleRenderer renderer(frameRate); // Throttled in-place redraw
+			std::uint8_t lastPocket = 0; // Most recent spin, drawn with the next frame
+			StepResult lastStep;
+            bool keepPlaying = true;
+
+			auto composeFrame = [&](std::ostream& os) { // Format one frame from the latest spin and the counters
+                const RouletteOutcome& o = outcomeTable[lastPocket];
+                os << "\nOutcome: " << numberToString(o.number)
+                    << " (" << colorToString(o.color)
+                    << ", " << parityToString(o.parity) << ")\n";
+                if (lastStep.won) os << "You WIN! Net change: $" << lastStep.net << "\n";
+                else os << "You lose. Net change: $" << lastStep.net << "\n";
+                if (lastStep.switchedColor) { // Switched color
+                    os << "Reached " << lossThreshold << " losses  switching to "
+                        << colorToString(session.betColor) << ".\n";
+                }
+                stats.print(session.bankroll, session.currentBet, session.consecutiveLosses, session.betColor, os);
+                };
 
-            if (playMode != PlayMode::CONTINUOUS &&
-				bankroll - startingBankroll >= nextProfitThresh) { // Check profit threshold
-                std::cout << "You are up by $" << bankroll - startingBankroll << ". Continue? (y/n): ";
+			auto askYesNo = [&](const std::string& prompt) { // Blocking prompt, keys back to line input meanwhile
+                keys.suspend();
+                std::cout << prompt;
                 char c; std::cin >> c; std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-                if (c != 'y' && c != 'Y') return false;
-                nextProfitThresh += startingBankroll;
-            }
-            return true;
-            };
+                keys.resume();
+                return c == 'y' || c == 'Y';
+                };
+			auto sessionMenu = [&](const std::string& reason) -> bool { // Pause for instructions; false = stop
+                renderer.present(composeFrame, true);
+                keys.suspend();
+                const std::string line = ui.getLine(reason + " c = continue, s = stop, b AMOUNT = next bet: ");
+                keys.resume();
+                std::istringstream in(line);
+                char c = 'c'; in >> c;
+                if (c == 's' || c == 'S') return false;
+                double amount = 0;
+                if ((c == 'b' || c == 'B') && in >> amount) {
+                    if (amount > 0 && amount <= maxBet) session.currentBet = amount; // takes effect on the next spin
+                    else std::cout << "A bet must be above $0 and at most $" << maxBet << " \x96 unchanged.\n";
+                }
+                return true;
+                };
+
+            // Lambda for one spin
+			auto spinOnce = [&]() -> bool { // Spin once and update bankroll
+				if (playMode == PlayMode::MANUAL) { // Manual play
+                    std::cout << "Press <Enter> to spin...";
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                }
+				const std::uint8_t pocket = wheel.spinIndex(); // Spin the wheel
+
+				const StepResult step = stepSession(session, params, pocket); // Settle bets, advance the strategy
+				stats.recordSpin(pocket, step, session); // History, win/loss counters
+                lastPocket = pocket; lastStep = step;
+                timer.addSpin();
+
+				const bool prompting = profitPolicy == ProfitPolicy::ASK && step.profitThresholdReached;
+				renderer.present(composeFrame, playMode == PlayMode::MANUAL || prompting); // Manual spins and prompts always draw
+				if (step.profitThresholdReached) { // Check profit threshold
+                    if (profitPolicy == ProfitPolicy::STOP) return false;
+                    std::ostringstream up; up << "You are up by $" << session.bankroll - startingBankroll << ". Continue? (y/n): ";
+                    if (prompting && !askYesNo(up.str())) return false;
+                    acknowledgeProfitThreshold(session, params);
+                }
+				if (capPause > 0 && session.capRun == capPause) { // Settled the old TODO: stop, continue or change the bet
+                    if (!sessionMenu("Max bet hit " + std::to_string(capPause) + " times in a row.")) return false;
+                }
+				if (const char key = keys.poll()) { // Keys never hold up the run; they are checked between spins
+                    if (key == 's' || key == 'S' || key == 'q' || key == 'Q') return false;
+                    if ((key == 'p' || key == 'P' || key == 'b' || key == 'B') && !sessionMenu("Paused.")) return false;
+                }
+                return true;
+                };
 
-        // -- Main game loop
-        while (bankroll > 0 && !timer.isTimeUp() && keepPlaying && currentBet <= bankroll) {
-			if (playMode == PlayMode::CONTINUOUS) { // Continuous play
-                if (!spinOnce()) break;
-            }
-			else if (playMode == PlayMode::AUTOPLAY) { // Auto-play
-                for (int i = 0; i < autoSpins && bankroll > 0 && !timer.isTimeUp(); ++i) {
-                    if (!spinOnce()) { keepPlaying = false; break; }
+            // -- Main game loop
+            while (sessionActive(session) && keepPlaying) {
+				if (playMode == PlayMode::CONTINUOUS) { // Continuous play
+                    if (!spinOnce()) break;
                 }
-				if (keepPlaying) { // Ask to continue after auto-spins
-                    std::cout << "Auto-spin block done. Continue? (y/n): ";
-                    char c; std::cin >> c; std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-                    if (c != 'y' && c != 'Y') break;
+				else if (playMode == PlayMode::AUTOPLAY) { // Auto-play
+                    for (int i = 0; i < autoSpins && sessionActive(session); ++i) {
+                        if (!spinOnce()) { keepPlaying = false; break; }
+                    }
+					if (keepPlaying) { // Ask to continue after auto-spins, unless the run is unattended
+                        renderer.present(composeFrame, true);
+                        if (profitPolicy == ProfitPolicy::ASK && !askYesNo("Auto-spin block done. Continue? (y/n): ")) break;
+                    }
+                }
+				else { // Manual play
+                    if (!spinOnce()) break;
                 }
             }
-			else { // Manual play
-                if (!spinOnce()) break;
-            }
-        }
-
-        // -- Final summary
-        std::cout << "\n=== Final Stats ===\n";
-        stats.print(bankroll, currentBet, consecutiveLosses, betColor);
-        std::cout << "Simulated play time: " << (timer.seconds() / 3600.0) << " hours\n"
-            << "Starting bankroll: $" << startingBankroll << "\n"
-            << "Final bankroll:   $" << bankroll << "\n"
-            << "Net " << (bankroll >= startingBankroll ? "profit: $" : "loss: $")
-            << std::abs(bankroll - startingBankroll) << "\n"
-            << "Max-bet cap hit: " << maxBetHits << " times\n";
+            if (stats.spins() > 0) renderer.present(composeFrame, true); // Last frame shows the final spin
+            bankroll = session.bankroll; // carried into a same-bankroll restart
+
+            // -- Final summary
+            std::cout << "\n=== Final Stats ===\n";
+            stats.print(session.bankroll, session.currentBet, session.consecutiveLosses, session.betColor);
+            std::cout << "Simulated play time: " << (timer.seconds() / 3600.0) << " hours\n"
+                << "Starting bankroll: $" << startingBankroll << "\n"
+                << "Final bankroll:   $" << bankroll << "\n"
+                << "Net " << (bankroll >= startingBankroll ? "profit: $" : "loss: $")
+                << std::abs(bankroll - startingBankroll) << "\n"
+                << "Max-bet cap hit: " << session.maxBetHits << " times\n";
+		}
 
         // -- Game over options
         std::cout << "\nGame over. Choose an option:\n"
@@ -407,7 +756,7 @@ int main() { // Main function
 		else { // Quit
             playAgain = false;
         }
-		system("cls");
+		ConsoleControl::clearScreen();
     } while (playAgain);
 
     return 0;
@@ -0,0 +1,222 @@
+// ============================================================================
+//  RouletteCore.h - wheel, RNG, bet modes and timer shared by the app and the
+//  headless simulation engine
+//  Build:  C++20, Visual Studio 2022 (x64, Windows)
+// ============================================================================
+#pragma once
+
+// ----- Standard C++ headers -------------------------------------------------
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <thread>
+
+// ----- Project headers ------------------------------------------------------
+#include "RandomGenerators.h"
+
+// ============================================================================
+//  Enums, Helpers, and Classes
+// ============================================================================
+enum class Color { RED, BLACK, GREEN };
+enum class Parity { ODD, EVEN, NONE };
+enum class PlayMode { MANUAL, AUTOPLAY, CONTINUOUS, BATCH, EXACT, SWEEP, IMPORTANCE };
+
+inline std::string numberToString(int num) { // Convert number to string; pockets past 36 are the extra zeros
+    return num == 37 ? "00" : num == 38 ? "000" : std::to_string(num);
+}
+inline std::string colorToString(Color c) { // Convert color to string
+    switch (c) { case Color::RED: return "Red"; case Color::BLACK: return "Black"; case Color::GREEN: return "Green"; }
+    return "Unknown";
+}
+inline std::string parityToString(Parity p) { // Convert parity to string
+    switch (p) { case Parity::ODD: return "Odd"; case Parity::EVEN: return "Even"; case Parity::NONE: return "None"; }
+    return "Unknown";
+}
+
+// ----------------------------------------------------------------------------
+//  RandomNumberGenerator - bounded draws on top of a generator policy from
+//  RandomGenerators.h (xoshiro256++ by default; std::mt19937 for reference)
+// ----------------------------------------------------------------------------
+template<class Generator>
+class BasicRandomNumberGenerator { // Random number generator class
+public:
+    BasicRandomNumberGenerator() { gen.seed(randomMasterSeed(), 0); }
+    BasicRandomNumberGenerator(std::uint64_t masterSeed, std::uint64_t stream) { reseed(masterSeed, stream); }
+    void reseed(std::uint64_t masterSeed, std::uint64_t stream) { gen.seed(masterSeed, stream); } // Jump to an independent stream
+    std::uint32_t below(std::uint32_t range) { return boundedRandom(gen, range); } // Uniform in [0, range)
+    void fillBelow(std::span<std::uint8_t> out, std::uint32_t range) { // Bulk draws; SIMD when the policy has it
+        if constexpr (requires { gen.fillBelow(out, range); }) gen.fillBelow(out, range);
+        else for (auto& o : out) o = static_cast<std::uint8_t>(below(range));
+    }
+    int getRandomNumber(int min, int max) { return min + static_cast<int>(below(static_cast<std::uint32_t>(max - min + 1))); }
+private:
+    Generator gen;
+};
+using RandomNumberGenerator = BasicRandomNumberGenerator<Xoshiro256PlusPlus>;
+
+struct RouletteOutcome { // Roulette outcome structure
+    int number;
+    Color color;
+    Parity parity;
+};
+
+// ----------------------------------------------------------------------------
+//  Outcome table - every pocket classified at compile time. Pockets 0-36 are
+//  the numbers; 37 is "00" and 38 is "000" on wheels that have them. The hot
+//  loop deals in pocket indices and looks the rest up here.
+// ----------------------------------------------------------------------------
+inline constexpr int maxWheelPockets = 39; // triple-zero wheel
+inline constexpr std::uint64_t redPocketMask = // bit n set = pocket n is red
+    (1ull << 1) | (1ull << 3) | (1ull << 5) | (1ull << 7) | (1ull << 9) | (1ull << 12) |
+    (1ull << 14) | (1ull << 16) | (1ull << 18) | (1ull << 19) | (1ull << 21) | (1ull << 23) |
+    (1ull << 25) | (1ull << 27) | (1ull << 30) | (1ull << 32) | (1ull << 34) | (1ull << 36);
+static_assert(std::popcount(redPocketMask) == 18, "18 red pockets");
+
+ROULETTE_HOST_DEVICE constexpr bool isGreenPocket(int n) { return n == 0 || n > 36; }
+constexpr RouletteOutcome classifyPocket(int n) { // Color and parity of one pocket
+    if (isGreenPocket(n)) return { n, Color::GREEN, Parity::NONE };
+    return { n, ((redPocketMask >> n) & 1) ? Color::RED : Color::BLACK, (n % 2 == 0) ? Parity::EVEN : Parity::ODD };
+}
+inline constexpr std::array<RouletteOutcome, maxWheelPockets> outcomeTable = [] { // any wheel's pocket, by index
+    std::array<RouletteOutcome, maxWheelPockets> t{};
+    for (int n = 0; n < maxWheelPockets; ++n) t[n] = classifyPocket(n);
+    return t;
+}();
+
+// Pocket class bits, one byte per spin, for table/shuffle based classification
+inline constexpr std::uint8_t pocketRed = 1, pocketBlack = 2, pocketGreen = 4, pocketOdd = 8, pocketEven = 16;
+inline constexpr std::array<std::uint8_t, 48> pocketClassTable = [] { // padded to three 16-byte rows
+    std::array<std::uint8_t, 48> t{};
+    for (int n = 0; n < maxWheelPockets; ++n) {
+        const RouletteOutcome& o = outcomeTable[n];
+        t[n] = static_cast<std::uint8_t>((o.color == Color::RED ? pocketRed : 0) | (o.color == Color::BLACK ? pocketBlack : 0) |
+            (o.color == Color::GREEN ? pocketGreen : 0) | (o.parity == Parity::ODD ? pocketOdd : 0) | (o.parity == Parity::EVEN ? pocketEven : 0));
+    }
+    return t;
+}();
+ROULETTE_HOST_DEVICE constexpr std::uint8_t colorClassBit(Color c) { // Class bit a bet on `c` wins on
+    return c == Color::RED ? pocketRed : c == Color::BLACK ? pocketBlack : pocketGreen;
+}
+
+// ----------------------------------------------------------------------------
+//  Wheel layouts - the pocket count and outcome table of each variant as
+//  compile-time constants. Wheels, lanes and farms take the
+//  layout as a template parameter, so the RNG range is a constant in the hot
+//  loop; WheelKind picks one at run time, once per batch or session.
+// ----------------------------------------------------------------------------
+template<int Zeros>
+struct WheelLayout {
+    static_assert(Zeros >= 1 && 36 + Zeros <= maxWheelPockets, "0, 00 and 000 are the only zeros");
+    static constexpr int zeros = Zeros;               // green pockets
+    static constexpr int pockets = 36 + Zeros;        // RNG range; indices 0..pockets-1
+    static constexpr std::array<RouletteOutcome, pockets> outcomes = [] {
+        std::array<RouletteOutcome, pockets> t{};
+        for (int n = 0; n < pockets; ++n) t[n] = outcomeTable[n];
+        return t;
+    }();
+};
+using EuropeanLayout = WheelLayout<1>;   // 0
+using AmericanLayout = WheelLayout<2>;   // 0, 00
+using TripleZeroLayout = WheelLayout<3>; // 0, 00, 000
+
+enum class WheelKind : std::uint8_t { EUROPEAN, AMERICAN, TRIPLE_ZERO };
+
+constexpr int wheelZeros(WheelKind k) { return k == WheelKind::EUROPEAN ? 1 : k == WheelKind::TRIPLE_ZERO ? 3 : 2; }
+constexpr int wheelPocketCount(WheelKind k) { return 36 + wheelZeros(k); }
+inline std::string wheelKindToString(WheelKind k) { // Convert wheel kind to string
+    switch (k) { case WheelKind::EUROPEAN: return "European (0)"; case WheelKind::TRIPLE_ZERO: return "Triple zero (0, 00, 000)"; default: return "American (0, 00)"; }
+}
+
+// Call f(Layout{}) for the layout behind `k`; the one runtime branch of a run
+template<class F>
+decltype(auto) withWheelLayout(WheelKind k, F&& f) {
+    switch (k) {
+    case WheelKind::EUROPEAN: return f(EuropeanLayout{});
+    case WheelKind::TRIPLE_ZERO: return f(TripleZeroLayout{});
+    default: return f(AmericanLayout{});
+    }
+}
+
+template<class Generator = Xoshiro256PlusPlus, class Layout = AmericanLayout>
+class BasicRouletteWheel { // Roulette wheel class
+public:
+    using generator_type = Generator;
+    using layout_type = Layout;
+
+    BasicRouletteWheel() : rng() {}
+    BasicRouletteWheel(std::uint64_t masterSeed, std::uint64_t stream) : rng(masterSeed, stream) {}
+    void reseed(std::uint64_t masterSeed, std::uint64_t stream) { rng.reseed(masterSeed, stream); }
+    RouletteOutcome spin() { return Layout::outcomes[spinIndex()]; }
+    std::uint8_t spinIndex() { return static_cast<std::uint8_t>(rng.below(Layout::pockets)); } // Pocket only
+    void spinBatch(std::span<std::uint8_t> out) { rng.fillBelow(out, Layout::pockets); } // Fill with pocket indices
+private:
+    BasicRandomNumberGenerator<Generator> rng;
+};
+using RouletteWheel = BasicRouletteWheel<>;
+
+// ----------------------------------------------------------------------------
+//  AnyRouletteWheel - every layout behind one object for the interactive
+//  loop, where a switch per spin is nothing next to the console; batch paths
+//  go through withWheelLayout() instead and never see this branch.
+// ----------------------------------------------------------------------------
+template<class Generator = Xoshiro256PlusPlus>
+class BasicAnyRouletteWheel { // Runtime-selected wheel
+public:
+    explicit BasicAnyRouletteWheel(WheelKind k = WheelKind::AMERICAN) : kind(k) {}
+    void select(WheelKind k) { kind = k; }
+    WheelKind selected() const { return kind; }
+    RouletteOutcome spin() { return outcomeTable[spinIndex()]; }
+    std::uint8_t spinIndex() {
+        switch (kind) {
+        case WheelKind::EUROPEAN: return european.spinIndex();
+        case WheelKind::TRIPLE_ZERO: return tripleZero.spinIndex();
+        default: return american.spinIndex();
+        }
+    }
+private:
+    WheelKind kind;
+    BasicRouletteWheel<Generator, EuropeanLayout> european;
+    BasicRouletteWheel<Generator, AmericanLayout> american;
+    BasicRouletteWheel<Generator, TripleZeroLayout> tripleZero;
+};
+using AnyRouletteWheel = BasicAnyRouletteWheel<>;
+
+class BettingStrategy { // Betting strategy class
+public:
+    explicit BettingStrategy(std::vector<double> m) : multipliers(std::move(m)) {
+        if (multipliers.empty()) multipliers = { 3.0,3.0,2.0 };
+    }
+    double getMultiplier(int n) const {
+        if (n <= static_cast<int>(multipliers.size())) return multipliers[n - 1];
+        return multipliers.back();
+    }
+    const std::vector<double>& values() const { return multipliers; }
+private:
+    std::vector<double> multipliers;
+};
+
+// ----------------------------------------------------------------------------
+//  CasinoTimer - simulated clock; 35 s of casino time per spin, 8 h session cap.
+//  The real-time sleep is a presentation setting only (off by default) so the
+//  batch engine never pays for it.
+// ----------------------------------------------------------------------------
+class CasinoTimer { // Casino timer class
+public:
+    static constexpr int secondsPerSpin = 35;     // simulated seconds per spin
+    static constexpr int sessionLimit = 8 * 3600; // 8-hour session cap
+
+    explicit CasinoTimer(std::chrono::milliseconds delay = std::chrono::milliseconds(0)) : presentationDelay(delay) {}
+    void addSpin() {
+        if (presentationDelay.count() > 0) std::this_thread::sleep_for(presentationDelay); // Presentation only
+        elapsed += secondsPerSpin;
+    }
+    bool isTimeUp() const { return elapsed >= sessionLimit; }
+    int seconds() const { return elapsed; }
+private:
+    std::chrono::milliseconds presentationDelay;
+    int elapsed = 0;
+};
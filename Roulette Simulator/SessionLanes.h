@@ -0,0 +1,353 @@
+// ============================================================================
+//  SessionLanes.h - structure-of-arrays session stepper. Advances groups of
+//  independent sessions in lockstep with their state held in vector registers;
+//  the win/loss, cap and color branches become masked blends (AVX-512 or AVX2,
+//  plain selects otherwise, chosen at run time). Finished lanes are retired
+//  and refilled.
+//  Build:  C++20, Visual Studio 2022 (x64, Windows)
+// ============================================================================
+#pragma once
+
+#include "CpuDispatch.h"
+#include "RouletteCore.h"
+#include "StrategyKernel.h"
+#include "SpinBatch.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(ROULETTE_SIMD_AVX512) || defined(ROULETTE_SIMD_AVX2)
+#include <immintrin.h>
+#endif
+
+// ============================================================================
+//  SessionLanes<Lanes, Generator, Layout>
+//  Lane l plays session i from stream (masterSeed, i) and draws its pockets in
+//  the same 64-spin blocks as the scalar loop, doing the same double arithmetic
+//  in the same order, so every session ends exactly as it would under
+//  stepSession(). A group stays in registers until one of its lanes finishes
+//  or empties its pocket buffer; only then does state go back to the arrays.
+//  Counters are doubles (small exact integers) so one width covers every field.
+//  Side bets come from the payout table: a green / not-green blend when the
+//  table allows it, otherwise one gather from the table per spin.
+// ============================================================================
+template<int Lanes, class Generator, class Layout = AmericanLayout>
+class SessionLanes {
+public:
+    static constexpr std::size_t spinBlock = 64; // pockets drawn per spinBatch call
+#if defined(ROULETTE_SIMD_AVX512)
+    static constexpr int widestGroup = 8;        // lanes per register group on the widest path built
+#elif defined(ROULETTE_SIMD_AVX2)
+    static constexpr int widestGroup = 4;
+#else
+    static constexpr int widestGroup = 1;
+#endif
+    static_assert(Lanes % widestGroup == 0, "lanes must fill whole register groups");
+
+    explicit SessionLanes(const StrategyParams& p) : params(p), groupWidth(chooseGroupWidth()) {
+        for (int l = 0; l < Lanes; ++l) laneOffset[l] = static_cast<std::int64_t>(l) * classStride;
+    }
+
+    // Play sessions [begin, end) of stream space; onDone(sessionIndex, result) fires as each one finishes
+    template<class OnDone>
+    void runRange(std::uint64_t masterSeed, std::uint64_t begin, std::uint64_t end, OnDone&& onDone) {
+        nextSession = begin; lastSession = end; seed = masterSeed;
+        int live = 0;
+        for (int l = 0; l < Lanes; ++l) live += refill(l, onDone) ? 1 : 0;
+
+        while (live > 0) {
+            for (int g = 0; g < Lanes; g += groupWidth) advanceGroup(g);
+            for (int l = 0; l < Lanes; ++l) { // Top up empty buffers, retire and refill finished lanes
+                if (active[l] == 0.0) continue;
+                if (running[l] != 0.0) { if (next[l] == static_cast<std::int64_t>(spinBlock)) drawBlock(l); continue; }
+                onDone(session[l], laneResult(l));
+                if (!refill(l, onDone)) --live;
+            }
+        }
+    }
+
+private:
+    static constexpr std::size_t classStride = spinBlock + 8; // 8-byte gathers may read past the last class or pocket
+    static constexpr double spinLimit = // spins that fit in the 8-hour session
+        (CasinoTimer::sessionLimit + CasinoTimer::secondsPerSpin - 1) / CasinoTimer::secondsPerSpin;
+    static constexpr std::int64_t colorFlip = pocketRed ^ pocketBlack;
+
+    bool laneRunning(int l) const {
+        return bankroll[l] > 0 && spins[l] < spinLimit && currentBet[l] <= bankroll[l];
+    }
+    SessionResult laneResult(int l) const {
+        SessionResult r;
+        r.finalBankroll = bankroll[l];
+        r.spins = static_cast<int>(spins[l]);
+        r.maxBetHits = static_cast<int>(maxBetHits[l]);
+        r.longestLossStreak = static_cast<int>(longestStreak[l]);
+        r.ruined = bankroll[l] <= 0 || currentBet[l] > bankroll[l];
+        return r;
+    }
+    void drawBlock(int l) { // Next 64 pockets of the lane's stream, classified up front
+        const std::span<std::uint8_t> pockets(pocketBuf + laneOffset[l], spinBlock);
+        wheels[l].spinBatch(pockets);
+        classifyPockets(pockets, std::span<std::uint8_t>(classBuf + laneOffset[l], spinBlock));
+        next[l] = 0;
+    }
+    template<class OnDone>
+    bool refill(int l, OnDone& onDone) { // Load the next playable session into lane l, or park it
+        while (nextSession < lastSession) {
+            session[l] = nextSession++;
+            bankroll[l] = params.startingBankroll; currentBet[l] = params.initialBet;
+            consecutiveLosses[l] = 0; consecutiveWins[l] = 0; maxBetHits[l] = 0; spins[l] = 0;
+            lossStreak[l] = 0; longestStreak[l] = 0;
+            betColor[l] = pocketBlack;
+            if (!laneRunning(l)) { onDone(session[l], laneResult(l)); continue; } // cannot open (bet above bankroll)
+            wheels[l].reseed(seed, session[l]);
+            drawBlock(l);
+            active[l] = 1.0; running[l] = 1.0;
+            return true;
+        }
+        active[l] = 0.0; running[l] = 0.0;
+        return false;
+    }
+
+    static int chooseGroupWidth() { // 8 lanes per zmm, 4 per ymm, else one at a time
+        const SimdLevel simd = simdLevel();
+        (void)simd;
+#if defined(ROULETTE_SIMD_AVX512)
+        if (simd >= SimdLevel::AVX512) return 8;
+#endif
+#if defined(ROULETTE_SIMD_AVX2)
+        if (simd >= SimdLevel::AVX2) return 4;
+#endif
+        return 1;
+    }
+    void advanceGroup(int g) { // Play lanes [g, g + groupWidth) until one finishes or runs out of pockets
+        switch (groupWidth) {
+#if defined(ROULETTE_SIMD_AVX512)
+        case 8: if (params.side.greenOnly) advanceAvx512<false>(g); else advanceAvx512<true>(g); break;
+#endif
+#if defined(ROULETTE_SIMD_AVX2)
+        case 4: if (params.side.greenOnly) advanceAvx2<false>(g); else advanceAvx2<true>(g); break;
+#endif
+        default: advanceScalar(g); break;
+        }
+    }
+    std::int64_t stepsAvailable(int g) const { // Spins every running lane of the group can take from its buffer
+        std::int64_t steps = static_cast<std::int64_t>(spinBlock);
+        for (int l = g; l < g + groupWidth; ++l)
+            if (running[l] != 0.0 && static_cast<std::int64_t>(spinBlock) - next[l] < steps) steps = static_cast<std::int64_t>(spinBlock) - next[l];
+        return steps;
+    }
+
+    // Reference form of the lane step; the vector paths below are this loop with every branch as a blend
+    void advanceScalar(int l) {
+        if (running[l] == 0.0) return;
+        const double lossLast = params.loss.count - 1, winLast = params.win.count - 1;
+        double bank = bankroll[l], bet = currentBet[l], wins = consecutiveWins[l], losses = consecutiveLosses[l];
+        double hits = maxBetHits[l], spun = spins[l], streak = lossStreak[l], longest = longestStreak[l];
+        std::int64_t color = betColor[l], k = next[l];
+        bool stillRunning = true;
+        while (stillRunning && k < static_cast<std::int64_t>(spinBlock)) {
+            const std::uint8_t cls = classBuf[laneOffset[l] + k];
+            const double extra = params.side[pocketBuf[laneOffset[l] + k++]];
+            const bool win = (cls & color) != 0;
+            bank += (win ? bet : -bet) + extra;
+            wins = win ? wins + 1 : 0.0;
+            losses = win ? 0.0 : losses + 1;
+            streak = win ? 0.0 : streak + 1;
+            longest = streak > longest ? streak : longest;
+
+            double wi = wins - 1, li = losses - 1; // clamp to [0, last]
+            wi = wi > winLast ? winLast : wi; wi = wi < 0 ? 0 : wi;
+            li = li > lossLast ? lossLast : li; li = li < 0 ? 0 : li;
+            const double winBet = params.useWinMult ? params.initialBet * params.win.values[static_cast<int>(wi)] : params.initialBet;
+            double newBet = win ? winBet : bet * params.loss.values[static_cast<int>(li)];
+            const bool cap = (!win || params.useWinMult) && newBet >= params.maxBet; // a reset to the initial bet is never capped
+            bet = cap ? params.maxBet : newBet;
+            wins = (win && !params.useWinMult) ? 0.0 : wins;
+
+            const bool flip = losses >= params.lossThreshold;
+            losses = flip ? 0.0 : losses;
+            color ^= flip ? colorFlip : 0;
+            hits += cap ? 1.0 : 0.0;
+            spun += 1.0;
+            stillRunning = bank > 0 && spun < spinLimit && bet <= bank;
+        }
+        bankroll[l] = bank; currentBet[l] = bet; consecutiveWins[l] = wins; consecutiveLosses[l] = losses;
+        maxBetHits[l] = hits; spins[l] = spun; betColor[l] = color; next[l] = k;
+        lossStreak[l] = streak; longestStreak[l] = longest;
+        running[l] = stillRunning ? 1.0 : 0.0;
+    }
+
+#if defined(ROULETTE_SIMD_AVX512)
+    template<bool GatherPayouts>
+    ROULETTE_TARGET("avx512f") void advanceAvx512(int g) { // 8 lanes per zmm, branches as k-masks
+        const __m512d zero = _mm512_setzero_pd(), one = _mm512_set1_pd(1.0);
+        __mmask8 play = _mm512_cmp_pd_mask(_mm512_load_pd(running + g), zero, _CMP_NEQ_OQ);
+        if (!play) return;
+        const std::int64_t steps = stepsAvailable(g);
+
+        const __m512d extraWin = _mm512_set1_pd(params.side[0]);
+        const __m512d extraLose = _mm512_set1_pd(params.side[1]);
+        const __m512d initialBet = _mm512_set1_pd(params.initialBet), maxBet = _mm512_set1_pd(params.maxBet);
+        const __m512d lossLast = _mm512_set1_pd(params.loss.count - 1), winLast = _mm512_set1_pd(params.win.count - 1);
+        const __m512d threshold = _mm512_set1_pd(params.lossThreshold), limit = _mm512_set1_pd(spinLimit);
+        const __m512i greenBit = _mm512_set1_epi64(pocketGreen), flipBits = _mm512_set1_epi64(colorFlip), step = _mm512_set1_epi64(1);
+        const __mmask8 useWin = params.useWinMult ? 0xFF : 0x00;
+        const __m512i offset = _mm512_load_si512(laneOffset + g);
+
+        __m512d bank = _mm512_load_pd(bankroll + g), bet = _mm512_load_pd(currentBet + g);
+        __m512d wins = _mm512_load_pd(consecutiveWins + g), losses = _mm512_load_pd(consecutiveLosses + g);
+        __m512d hits = _mm512_load_pd(maxBetHits + g), spun = _mm512_load_pd(spins + g);
+        __m512d streak = _mm512_load_pd(lossStreak + g), longest = _mm512_load_pd(longestStreak + g);
+        __m512i color = _mm512_load_si512(betColor + g);
+        __m512i cursor = _mm512_add_epi64(_mm512_load_si512(next + g), offset);
+
+        for (std::int64_t k = 0; k < steps; ++k) {
+            const __m512i cls = _mm512_i64gather_epi64(cursor, classBuf, 1);
+            const __mmask8 win = _mm512_test_epi64_mask(cls, color);
+            __m512d extra;
+            if constexpr (GatherPayouts) { // the lane's pocket indexes the payout table
+                const __m512i pocket = _mm512_and_si512(_mm512_i64gather_epi64(cursor, pocketBuf, 1), _mm512_set1_epi64(0xFF));
+                extra = _mm512_i64gather_pd(pocket, params.side.net.data(), 8);
+            }
+            else extra = _mm512_mask_blend_pd(_mm512_test_epi64_mask(cls, greenBit), extraLose, extraWin);
+            const __m512d signedBet = _mm512_mask_blend_pd(win, _mm512_sub_pd(zero, bet), bet);
+            bank = _mm512_mask_add_pd(bank, play, bank, _mm512_add_pd(signedBet, extra));
+
+            const __m512d newWins = _mm512_maskz_add_pd(win, wins, one);
+            const __m512d newLosses = _mm512_maskz_add_pd(static_cast<__mmask8>(~win), losses, one);
+            const __m512d wi = _mm512_max_pd(_mm512_min_pd(_mm512_sub_pd(newWins, one), winLast), zero);
+            const __m512d li = _mm512_max_pd(_mm512_min_pd(_mm512_sub_pd(newLosses, one), lossLast), zero);
+            const __m512d winMult = _mm512_i32gather_pd(_mm512_cvttpd_epi32(wi), params.win.values.data(), 8);
+            const __m512d lossMult = _mm512_i32gather_pd(_mm512_cvttpd_epi32(li), params.loss.values.data(), 8);
+            const __m512d winBet = _mm512_mask_mul_pd(initialBet, useWin, initialBet, winMult);
+            __m512d newBet = _mm512_mask_blend_pd(win, _mm512_mul_pd(bet, lossMult), winBet);
+            const __mmask8 cap = static_cast<__mmask8>(_mm512_cmp_pd_mask(newBet, maxBet, _CMP_GE_OQ) & ~(win & ~useWin)); // not on a reset
+            newBet = _mm512_mask_blend_pd(cap, newBet, maxBet);
+            bet = _mm512_mask_mov_pd(bet, play, newBet);
+
+            const __mmask8 flip = _mm512_cmp_pd_mask(newLosses, threshold, _CMP_GE_OQ);
+            wins = _mm512_mask_mov_pd(wins, play, _mm512_maskz_mov_pd(static_cast<__mmask8>(~(win & ~useWin)), newWins));
+            losses = _mm512_mask_mov_pd(losses, play, _mm512_maskz_mov_pd(static_cast<__mmask8>(~flip), newLosses));
+            color = _mm512_mask_xor_epi64(color, static_cast<__mmask8>(play & flip), color, flipBits);
+            hits = _mm512_mask_add_pd(hits, static_cast<__mmask8>(play & cap), hits, one);
+            streak = _mm512_mask_mov_pd(streak, play, _mm512_maskz_add_pd(static_cast<__mmask8>(~win), streak, one));
+            longest = _mm512_max_pd(longest, streak);
+            spun = _mm512_mask_add_pd(spun, play, spun, one);
+            cursor = _mm512_mask_add_epi64(cursor, play, cursor, step);
+
+            const __mmask8 stillRunning = static_cast<__mmask8>(_mm512_cmp_pd_mask(bank, zero, _CMP_GT_OQ)
+                & _mm512_cmp_pd_mask(spun, limit, _CMP_LT_OQ) & _mm512_cmp_pd_mask(bet, bank, _CMP_LE_OQ));
+            const __mmask8 done = static_cast<__mmask8>(play & ~stillRunning);
+            play = static_cast<__mmask8>(play & stillRunning);
+            if (done) break;
+        }
+        _mm512_store_pd(bankroll + g, bank); _mm512_store_pd(currentBet + g, bet);
+        _mm512_store_pd(consecutiveWins + g, wins); _mm512_store_pd(consecutiveLosses + g, losses);
+        _mm512_store_pd(maxBetHits + g, hits); _mm512_store_pd(spins + g, spun);
+        _mm512_store_pd(lossStreak + g, streak); _mm512_store_pd(longestStreak + g, longest);
+        _mm512_store_si512(betColor + g, color);
+        _mm512_store_si512(next + g, _mm512_sub_epi64(cursor, offset));
+        _mm512_store_pd(running + g, _mm512_maskz_mov_pd(play, one));
+    }
+#endif
+#if defined(ROULETTE_SIMD_AVX2)
+    template<bool GatherPayouts>
+    ROULETTE_TARGET("avx2") void advanceAvx2(int g) { // 4 lanes per ymm, branches as all-ones compare masks
+        const __m256d zero = _mm256_setzero_pd(), one = _mm256_set1_pd(1.0);
+        const __m256d allOnes = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+        __m256d play = _mm256_cmp_pd(_mm256_load_pd(running + g), zero, _CMP_NEQ_OQ);
+        if (_mm256_movemask_pd(play) == 0) return;
+        const std::int64_t steps = stepsAvailable(g);
+
+        const __m256d extraWin = _mm256_set1_pd(params.side[0]);
+        const __m256d extraLose = _mm256_set1_pd(params.side[1]);
+        const __m256d initialBet = _mm256_set1_pd(params.initialBet), maxBet = _mm256_set1_pd(params.maxBet);
+        const __m256d lossLast = _mm256_set1_pd(params.loss.count - 1), winLast = _mm256_set1_pd(params.win.count - 1);
+        const __m256d threshold = _mm256_set1_pd(params.lossThreshold), limit = _mm256_set1_pd(spinLimit);
+        const __m256d useWin = params.useWinMult ? allOnes : zero;
+        const __m256i zeroI = _mm256_setzero_si256(), greenBit = _mm256_set1_epi64x(pocketGreen), flipBits = _mm256_set1_epi64x(colorFlip);
+        const __m256i offset = _mm256_load_si256(reinterpret_cast<const __m256i*>(laneOffset + g));
+        const long long* const classBase = reinterpret_cast<const long long*>(classBuf);
+
+        __m256d bank = _mm256_load_pd(bankroll + g), bet = _mm256_load_pd(currentBet + g);
+        __m256d wins = _mm256_load_pd(consecutiveWins + g), losses = _mm256_load_pd(consecutiveLosses + g);
+        __m256d hits = _mm256_load_pd(maxBetHits + g), spun = _mm256_load_pd(spins + g);
+        __m256d streak = _mm256_load_pd(lossStreak + g), longest = _mm256_load_pd(longestStreak + g);
+        __m256i color = _mm256_load_si256(reinterpret_cast<const __m256i*>(betColor + g));
+        __m256i cursor = _mm256_add_epi64(_mm256_load_si256(reinterpret_cast<const __m256i*>(next + g)), offset);
+
+        for (std::int64_t k = 0; k < steps; ++k) {
+            const __m256i cls = _mm256_i64gather_epi64(classBase, cursor, 1);
+            const __m256d win = _mm256_xor_pd(allOnes, _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(cls, color), zeroI)));
+            __m256d extra;
+            if constexpr (GatherPayouts) { // the lane's pocket indexes the payout table
+                const __m256i pocket = _mm256_and_si256(_mm256_i64gather_epi64(reinterpret_cast<const long long*>(pocketBuf), cursor, 1), _mm256_set1_epi64x(0xFF));
+                extra = _mm256_i64gather_pd(params.side.net.data(), pocket, 8);
+            }
+            else {
+                const __m256d green = _mm256_xor_pd(allOnes, _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(cls, greenBit), zeroI)));
+                extra = _mm256_blendv_pd(extraLose, extraWin, green);
+            }
+            const __m256d signedBet = _mm256_blendv_pd(_mm256_sub_pd(zero, bet), bet, win);
+            bank = _mm256_blendv_pd(bank, _mm256_add_pd(bank, _mm256_add_pd(signedBet, extra)), play);
+
+            const __m256d newWins = _mm256_and_pd(win, _mm256_add_pd(wins, one));
+            const __m256d newLosses = _mm256_andnot_pd(win, _mm256_add_pd(losses, one));
+            const __m256d wi = _mm256_max_pd(_mm256_min_pd(_mm256_sub_pd(newWins, one), winLast), zero);
+            const __m256d li = _mm256_max_pd(_mm256_min_pd(_mm256_sub_pd(newLosses, one), lossLast), zero);
+            const __m256d winMult = _mm256_mask_i32gather_pd(zero, params.win.values.data(), _mm256_cvttpd_epi32(wi), allOnes, 8);
+            const __m256d lossMult = _mm256_mask_i32gather_pd(zero, params.loss.values.data(), _mm256_cvttpd_epi32(li), allOnes, 8);
+            const __m256d winBet = _mm256_blendv_pd(initialBet, _mm256_mul_pd(initialBet, winMult), useWin);
+            __m256d newBet = _mm256_blendv_pd(_mm256_mul_pd(bet, lossMult), winBet, win);
+            const __m256d cap = _mm256_andnot_pd(_mm256_andnot_pd(useWin, win), _mm256_cmp_pd(newBet, maxBet, _CMP_GE_OQ)); // not on a reset
+            newBet = _mm256_blendv_pd(newBet, maxBet, cap);
+            bet = _mm256_blendv_pd(bet, newBet, play);
+
+            const __m256d flip = _mm256_cmp_pd(newLosses, threshold, _CMP_GE_OQ);
+            wins = _mm256_blendv_pd(wins, _mm256_andnot_pd(_mm256_andnot_pd(useWin, win), newWins), play);
+            losses = _mm256_blendv_pd(losses, _mm256_andnot_pd(flip, newLosses), play);
+            color = _mm256_xor_si256(color, _mm256_and_si256(_mm256_castpd_si256(_mm256_and_pd(play, flip)), flipBits));
+            hits = _mm256_add_pd(hits, _mm256_and_pd(_mm256_and_pd(play, cap), one));
+            streak = _mm256_blendv_pd(streak, _mm256_andnot_pd(win, _mm256_add_pd(streak, one)), play);
+            longest = _mm256_max_pd(longest, streak);
+            spun = _mm256_add_pd(spun, _mm256_and_pd(play, one));
+            cursor = _mm256_sub_epi64(cursor, _mm256_castpd_si256(play)); // all-ones is -1
+
+            const __m256d stillRunning = _mm256_and_pd(_mm256_and_pd(_mm256_cmp_pd(bank, zero, _CMP_GT_OQ),
+                _mm256_cmp_pd(spun, limit, _CMP_LT_OQ)), _mm256_cmp_pd(bet, bank, _CMP_LE_OQ));
+            const int done = _mm256_movemask_pd(_mm256_andnot_pd(stillRunning, play));
+            play = _mm256_and_pd(play, stillRunning);
+            if (done) break;
+        }
+        _mm256_store_pd(bankroll + g, bank); _mm256_store_pd(currentBet + g, bet);
+        _mm256_store_pd(consecutiveWins + g, wins); _mm256_store_pd(consecutiveLosses + g, losses);
+        _mm256_store_pd(maxBetHits + g, hits); _mm256_store_pd(spins + g, spun);
+        _mm256_store_pd(lossStreak + g, streak); _mm256_store_pd(longestStreak + g, longest);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(betColor + g), color);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(next + g), _mm256_sub_epi64(cursor, offset));
+        _mm256_store_pd(running + g, _mm256_and_pd(play, one));
+    }
+#endif
+
+    StrategyParams params;
+    int groupWidth;                       // lanes per advanceGroup() call, fixed per process
+    std::uint64_t seed = 0, nextSession = 0, lastSession = 0;
+
+    alignas(64) double bankroll[Lanes]{};
+    alignas(64) double currentBet[Lanes]{};
+    alignas(64) double consecutiveLosses[Lanes]{};
+    alignas(64) double consecutiveWins[Lanes]{};
+    alignas(64) double maxBetHits[Lanes]{};
+    alignas(64) double spins[Lanes]{};
+    alignas(64) double lossStreak[Lanes]{};
+    alignas(64) double longestStreak[Lanes]{};
+    alignas(64) double active[Lanes]{};         // lane holds a session
+    alignas(64) double running[Lanes]{};        // session can still play
+    alignas(64) std::int64_t betColor[Lanes]{}; // pocketRed or pocketBlack
+    alignas(64) std::int64_t next[Lanes]{};     // cursor into the lane's class buffer
+    alignas(64) std::int64_t laneOffset[Lanes]{}; // start of the lane's block in classBuf and pocketBuf
+    std::uint64_t session[Lanes]{};
+    alignas(64) std::uint8_t pocketBuf[Lanes * classStride]{}; // flat, so a gather cursor stays inside one array
+    alignas(64) std::uint8_t classBuf[Lanes * classStride]{};  // same layout as pocketBuf, so one cursor indexes both
+    BasicRouletteWheel<Generator, Layout> wheels[Lanes];
+};
@@ -0,0 +1,440 @@
+// ============================================================================
+//  SimulationEngine.h - headless Monte Carlo engine: runs full sessions of the
+//  betting strategy with no console I/O and no presentation delay, spread over
+//  all cores with deterministic per-session RNG streams
+//  Build:  C++20, Visual Studio 2022 (x64, Windows)
+// ============================================================================
+#pragma once
+
+#include "RouletteCore.h"
+#include "SpinBatch.h"
+#include "StrategyKernel.h"
+#include "SessionLanes.h"
+#include "StatsSketch.h"
+#include "StatsTracker.h"
+#include "StrategyProgram.h"
+#include "Telemetry.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+enum class SteppingMode { SCALAR, LANES }; // one session at a time, or 8 in lockstep
+enum class Accounting { DOLLARS, CENTS };  // double dollars, or exact integer cents (Money.h)
+
+struct BatchCheckpointHook;
+
+struct BatchOptions { // How a batch is run
+    std::uint64_t sessions = 0;           // number of sessions to play
+    std::uint64_t masterSeed = 0;         // session i draws from stream (masterSeed, firstSession + i)
+    std::uint64_t firstSession = 0;       // offset into the stream space, for splitting runs
+    unsigned threads = 0;                 // 0 = one per hardware thread
+    GeneratorKind generator = GeneratorKind::XOSHIRO256X8;
+    SteppingMode stepping = SteppingMode::LANES;
+    Accounting accounting = Accounting::DOLLARS; // CENTS always steps scalar; not available with a strategy program
+    std::vector<std::uint64_t> traceSessions; // session indices to export spin by spin; not available with a strategy program
+    std::string tracePath;                // CSV trace file; used when traceSessions is not empty
+    Telemetry* telemetry = nullptr;       // live progress counters, bumped once per chunk
+    BatchCheckpointHook* checkpoint = nullptr; // periodic snapshots, and chunks to skip on resume (Checkpoint.h)
+};
+
+struct BatchResult { // Aggregate over many sessions
+    std::uint64_t sessions = 0;
+    std::uint64_t ruined = 0;
+    std::uint64_t sessionsHittingMaxBet = 0;
+    std::uint64_t maxBetHits = 0;
+    std::uint64_t totalSpins = 0;
+    double ruinProbability = 0.0;
+    double meanFinalBankroll = 0.0;
+    double meanStdErr = 0.0;              // standard error of meanFinalBankroll
+    double finalSum = 0.0, finalSumSq = 0.0; // raw sums behind the mean, for merging batches
+    double p05 = 0.0, p25 = 0.0, median = 0.0, p75 = 0.0, p95 = 0.0; // final bankroll percentiles, from the sketch
+    SessionSketch distribution;           // mergeable with other batches' sketches
+};
+
+// Derived fields (ruin rate, mean, standard error, percentiles) from the counters, sums and sketch
+inline void finishBatchResult(BatchResult& r) {
+    if (r.sessions == 0) return;
+    const double n = static_cast<double>(r.sessions);
+    r.ruinProbability = static_cast<double>(r.ruined) / n;
+    r.meanFinalBankroll = r.finalSum / n;
+    const double variance = r.sessions > 1 ? std::max(0.0, (r.finalSumSq - n * r.meanFinalBankroll * r.meanFinalBankroll) / (n - 1)) : 0.0;
+    r.meanStdErr = std::sqrt(variance / n);
+    const LogHistogram& finals = r.distribution.finalBankroll;
+    r.p05 = finals.quantile(0.05); r.p25 = finals.quantile(0.25); r.median = finals.quantile(0.50);
+    r.p75 = finals.quantile(0.75); r.p95 = finals.quantile(0.95);
+}
+
+// ----------------------------------------------------------------------------
+//  Checkpointing. A snapshot is the finished part of a batch: the completed
+//  chunks, their partial sums, and the counters and sketch over them. Streams
+//  are counter-based, so the rest of the batch needs nothing else to resume.
+// ----------------------------------------------------------------------------
+struct BatchSnapshot {
+    std::vector<std::uint64_t> chunks;    // completed chunk indices, ascending
+    std::vector<double> chunkSums, chunkSquares; // by position in `chunks`
+    BatchResult partial;                  // over `chunks` only; a report of the batch so far
+};
+
+struct BatchCheckpointHook { // Snapshots of a running batch, taken without pausing the workers
+    std::chrono::milliseconds interval{ 5000 };
+    std::function<void(const BatchSnapshot&)> save; // from a snapshot thread, then once more with the whole batch
+    BatchSnapshot resume;                 // chunks an earlier run finished; they are skipped and their totals kept
+    std::string saveError;                // first failed save, if any; the batch itself carries on
+};
+
+// Fold a batch over a disjoint session range into `into`; sums are added in call order
+inline void mergeBatchResult(BatchResult& into, const BatchResult& part) {
+    into.sessions += part.sessions; into.ruined += part.ruined;
+    into.sessionsHittingMaxBet += part.sessionsHittingMaxBet; into.maxBetHits += part.maxBetHits;
+    into.totalSpins += part.totalSpins;
+    into.finalSum += part.finalSum; into.finalSumSq += part.finalSumSq;
+    into.distribution.merge(part.distribution);
+    finishBatchResult(into);
+}
+
+// ============================================================================
+//  SimulationEngine
+// ============================================================================
+class SimulationEngine { // Headless batch engine
+public:
+    // A configuration with a program is compiled here; syntax errors throw std::invalid_argument
+    explicit SimulationEngine(StrategyConfig cfg)
+        : config(std::move(cfg)), params(makeStrategyParams(config)),
+        program(config.program.empty() ? StrategyProgram() : StrategyProgram::compile(config.program)) {}
+
+    const StrategyConfig& settings() const { return config; }
+    static constexpr std::uint64_t chunkSize = 256; // sessions per scheduling chunk, and per partial sum of the mean
+
+    // Play one session to completion (ruin or the 8-hour limit) through the shared kernel, or the program
+    template<class Wheel>
+    SessionResult runSession(Wheel& wheel) const { return scripted() ? program.playSession(wheel, params) : playSession(wheel, params); }
+    bool scripted() const { return !config.program.empty(); }
+
+    // Same session under any Money policy, e.g. makeStrategyParams<CentMoney>(settings())
+    template<class Wheel, class Money>
+    static SessionResult playSession(Wheel& wheel, const BasicStrategyParams<Money>& rules) {
+        BasicSessionState<Money> state = startSession(rules);
+        std::uint8_t pockets[spinBlock], classes[spinBlock]; // outcomes are drawn and classified in bulk
+        std::size_t next = spinBlock;
+
+        while (sessionActive(state)) {
+            if (next == spinBlock) { wheel.spinBatch(pockets); classifyPockets(pockets, classes); next = 0; }
+            const int safe = std::min(safeSpins(state, rules), static_cast<int>(spinBlock - next));
+            if (safe > 1) { // rest of the block cannot end the session
+                advanceSession(state, rules, pockets + next, classes + next, safe);
+                next += static_cast<std::size_t>(safe);
+            }
+            else { stepSession(state, rules, pockets[next], classes[next]); ++next; }
+        }
+        return makeSessionResult(state);
+    }
+
+    // Same session, also fed spin by spin into a tracker; CounterStatsTracker keeps this allocation-free
+    template<class Wheel, std::size_t HistoryDepth>
+    SessionResult runSession(Wheel& wheel, BasicStatsTracker<HistoryDepth>& stats) const { return playSession(wheel, params, stats); }
+
+    // playSession() fed into a tracker, so a trace follows whichever Money policy the batch used
+    template<class Wheel, class Money, std::size_t HistoryDepth>
+    static SessionResult playSession(Wheel& wheel, const BasicStrategyParams<Money>& rules, BasicStatsTracker<HistoryDepth>& stats) {
+        BasicSessionState<Money> state = startSession(rules);
+        std::uint8_t pockets[spinBlock], classes[spinBlock];
+        std::size_t next = spinBlock;
+
+        while (sessionActive(state)) {
+            if (next == spinBlock) { wheel.spinBatch(pockets); classifyPockets(pockets, classes); next = 0; }
+            const BasicStepResult<Money> step = stepSession(state, rules, pockets[next], classes[next]);
+            stats.recordSpin(pockets[next], step, state);
+            ++next;
+        }
+        return makeSessionResult(state);
+    }
+
+    // Run a batch across all cores with the requested generator policy on the configured wheel
+    BatchResult run(const BatchOptions& opt) const {
+        return withWheelLayout(config.wheel, [&](auto layout) { // dispatch once; the session loop is fully specialized
+            using Layout = decltype(layout);
+            switch (opt.generator) {
+            case GeneratorKind::XOSHIRO256PP: return runFarm<Xoshiro256PlusPlus, Layout>(opt);
+            case GeneratorKind::PHILOX4X32: return runFarm<Philox4x32, Layout>(opt);
+            case GeneratorKind::MT19937: return runFarm<Mt19937Generator, Layout>(opt);
+            default: return runFarm<Xoshiro256x8, Layout>(opt);
+            }
+        });
+    }
+
+private:
+    // Sessions are handed out in fixed-size chunks from one atomic counter; each
+    // worker owns its wheel, accumulator and sketch, so nothing is locked. The
+    // floating sum is taken per chunk in session order and the chunk sums are
+    // added in chunk order, so the mean does not depend on the thread count.
+    //
+    // With a checkpoint hook every worker keeps two accumulators: one for the
+    // chunk it is playing, and a published one that the finished chunk is
+    // folded into under the worker's own lock, once per chunk. The snapshot
+    // thread reads only the published side, so workers never wait for it
+    // beyond one fold, and a snapshot always covers whole chunks.
+    template<class Generator, class Layout>
+    BatchResult runFarm(const BatchOptions& opt) const {
+        const std::uint64_t sessions = opt.sessions;
+        const std::uint64_t chunks = (sessions + chunkSize - 1) / chunkSize;
+        unsigned threads = opt.threads ? opt.threads : std::max(1u, std::thread::hardware_concurrency());
+        threads = static_cast<unsigned>(std::min<std::uint64_t>(threads, std::max<std::uint64_t>(chunks, 1)));
+
+        std::vector<double> chunkSums(static_cast<std::size_t>(chunks)), chunkSquares(static_cast<std::size_t>(chunks)); // written once per chunk
+        std::vector<WorkerTotals> totals(threads);
+        std::atomic<std::uint64_t> nextChunk{ 0 };
+        const bool cents = opt.accounting == Accounting::CENTS;
+        if (scripted() && cents) throw std::invalid_argument("Strategy programs keep their own variables in dollars; cent accounting is not available");
+        if (scripted() && !opt.traceSessions.empty() && !opt.tracePath.empty()) throw std::invalid_argument("Traces follow the built-in rules; they are not available with a strategy program");
+        for (std::uint64_t i : opt.traceSessions)
+            if (i >= sessions) throw std::invalid_argument("Cannot trace session " + std::to_string(i) + ": the batch has " + std::to_string(sessions) + " sessions, numbered from 0");
+        const BasicStrategyParams<CentMoney> centParams = cents ? makeStrategyParams<CentMoney>(config) : BasicStrategyParams<CentMoney>();
+
+        BatchCheckpointHook* const hook = opt.checkpoint;
+        std::vector<char> restored(hook ? static_cast<std::size_t>(chunks) : 0); // chunks finished by an earlier run
+        if (hook) {
+            const BatchSnapshot& r = hook->resume;
+            for (std::size_t k = 0; k < r.chunks.size(); ++k) {
+                const std::uint64_t c = r.chunks[k];
+                if (c >= chunks || restored[static_cast<std::size_t>(c)]) throw std::invalid_argument("Checkpoint does not belong to this batch");
+                restored[static_cast<std::size_t>(c)] = 1;
+                chunkSums[static_cast<std::size_t>(c)] = r.chunkSums[k]; chunkSquares[static_cast<std::size_t>(c)] = r.chunkSquares[k];
+            }
+            if (opt.telemetry) opt.telemetry->slot(0).addSessions(r.partial.sessions, r.partial.totalSpins, r.partial.ruined);
+        }
+        std::vector<PublishedTotals> published(hook ? threads : 0);
+
+        auto worker = [&](unsigned id) { // Pull chunks until the batch is exhausted
+            BasicRouletteWheel<Generator, Layout> wheel(opt.masterSeed, 0);
+            SessionLanes<laneCount, Generator, Layout> lanes(params);
+            WorkerTotals chunkTotals;     // checkpointed runs: the chunk in play
+            WorkerTotals& acc = hook ? chunkTotals : totals[id];
+            TelemetrySlot* slot = opt.telemetry ? &opt.telemetry->slot(id) : nullptr;
+            const bool lanesMode = opt.stepping == SteppingMode::LANES && !cents && !scripted(); // a program always steps one session at a time
+            const bool timed = slot && opt.telemetry->stageTiming && !lanesMode;
+            double finals[chunkSize]; // this chunk's final bankrolls, by session
+            for (std::uint64_t c; (c = nextChunk.fetch_add(1, std::memory_order_relaxed)) < chunks; ) {
+                if (hook && restored[static_cast<std::size_t>(c)]) continue;
+                const std::uint64_t begin = c * chunkSize, end = std::min(sessions, begin + chunkSize);
+                const std::uint64_t spinsBefore = acc.spins, ruinedBefore = acc.ruined;
+                auto record = [&](std::uint64_t i, const SessionResult& r) {
+                    finals[i - begin] = r.finalBankroll;
+                    acc.add(r);
+                };
+                if (lanesMode) { // stream ids are absolute, result slots relative
+                    lanes.runRange(opt.masterSeed, opt.firstSession + begin, opt.firstSession + end,
+                        [&](std::uint64_t s, const SessionResult& r) { record(s - opt.firstSession, r); });
+                }
+                else if (scripted()) {
+                    for (std::uint64_t i = begin; i < end; ++i) {
+                        wheel.reseed(opt.masterSeed, opt.firstSession + i);
+                        record(i, program.playSession(wheel, params));
+                    }
+                }
+                else if (timed) { // same sessions, with rdtsc around each stage
+                    StageCycles cycles;
+                    for (std::uint64_t i = begin; i < end; ++i) {
+                        wheel.reseed(opt.masterSeed, opt.firstSession + i);
+                        const SessionResult r = cents ? runSessionTimed(wheel, centParams, cycles) : runSessionTimed(wheel, params, cycles);
+                        const std::uint64_t t0 = cycleCount();
+                        record(i, r);
+                        cycles.add(Stage::STATS, cycleCount() - t0);
+                    }
+                    slot->addCycles(cycles);
+                }
+                else {
+                    for (std::uint64_t i = begin; i < end; ++i) {
+                        wheel.reseed(opt.masterSeed, opt.firstSession + i);
+                        record(i, cents ? playSession(wheel, centParams) : playSession(wheel, params));
+                    }
+                }
+                double sum = 0.0, squares = 0.0;
+                for (std::uint64_t i = 0; i < end - begin; ++i) { sum += finals[i]; squares += finals[i] * finals[i]; }
+                chunkSums[static_cast<std::size_t>(c)] = sum; chunkSquares[static_cast<std::size_t>(c)] = squares;
+                if (slot) slot->addSessions(end - begin, acc.spins - spinsBefore, acc.ruined - ruinedBefore);
+                if (hook) { // publish the chunk; its sums above are written before the lock
+                    PublishedTotals& p = published[id];
+                    std::lock_guard<std::mutex> lock(p.m);
+                    p.totals.merge(chunkTotals); p.chunks.push_back(c);
+                    chunkTotals = WorkerTotals();
+                }
+            }
+        };
+
+        // Everything finished so far, resumed chunks included
+        auto snapshot = [&] {
+            BatchSnapshot s;
+            WorkerTotals sum;
+            s.chunks = hook->resume.chunks;
+            for (PublishedTotals& p : published) {
+                std::lock_guard<std::mutex> lock(p.m);
+                sum.merge(p.totals);
+                s.chunks.insert(s.chunks.end(), p.chunks.begin(), p.chunks.end());
+            }
+            std::sort(s.chunks.begin(), s.chunks.end());
+            sum.addTo(s.partial);
+            const BatchResult& before = hook->resume.partial;
+            s.partial.ruined += before.ruined; s.partial.totalSpins += before.totalSpins;
+            s.partial.maxBetHits += before.maxBetHits; s.partial.sessionsHittingMaxBet += before.sessionsHittingMaxBet;
+            s.partial.distribution.merge(before.distribution);
+            for (std::uint64_t c : s.chunks) { // chunk order, as below
+                const std::size_t k = static_cast<std::size_t>(c);
+                s.chunkSums.push_back(chunkSums[k]); s.chunkSquares.push_back(chunkSquares[k]);
+                s.partial.finalSum += chunkSums[k]; s.partial.finalSumSq += chunkSquares[k];
+                s.partial.sessions += std::min(sessions, (c + 1) * chunkSize) - c * chunkSize;
+            }
+            finishBatchResult(s.partial);
+            return s;
+        };
+        std::mutex snapshotLock;
+        std::condition_variable snapshotWake;
+        bool workersDone = false;
+        auto save = [&](const BatchSnapshot& s) {
+            try { hook->save(s); }
+            catch (const std::exception& e) { if (hook->saveError.empty()) hook->saveError = e.what(); }
+        };
+        std::thread snapshotter;
+        if (hook && hook->save) snapshotter = std::thread([&] {
+            std::unique_lock<std::mutex> lock(snapshotLock);
+            while (!snapshotWake.wait_for(lock, hook->interval, [&] { return workersDone; })) {
+                lock.unlock();
+                save(snapshot());
+                lock.lock();
+            }
+        });
+
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker, t);
+        worker(0);
+        for (auto& th : pool) th.join();
+        if (snapshotter.joinable()) {
+            { std::lock_guard<std::mutex> lock(snapshotLock); workersDone = true; }
+            snapshotWake.notify_all();
+            snapshotter.join();
+        }
+
+        BatchResult out;
+        if (hook) { // the final snapshot is the whole batch
+            const BatchSnapshot last = snapshot();
+            if (hook->save) save(last);
+            out = last.partial;
+        }
+        else {
+            for (const auto& t : totals) t.addTo(out); // Integer counters and sketches merge identically in any order
+            out.sessions = sessions;
+            if (sessions == 0) return out;
+            for (std::size_t c = 0; c < chunkSums.size(); ++c) { // chunk order, independent of thread count
+                out.finalSum += chunkSums[c]; out.finalSumSq += chunkSquares[c];
+            }
+            finishBatchResult(out);
+        }
+        if (!opt.traceSessions.empty() && !opt.tracePath.empty()) writeTraces<Generator, Layout>(opt);
+        return out;
+    }
+
+    // runSession() with every 64-spin block split into its RNG, classify and step stages
+    template<class Wheel, class Money>
+    static SessionResult runSessionTimed(Wheel& wheel, const BasicStrategyParams<Money>& rules, StageCycles& cycles) {
+        BasicSessionState<Money> state = startSession(rules);
+        std::uint8_t pockets[spinBlock], classes[spinBlock];
+        while (sessionActive(state)) {
+            const std::uint64_t t0 = cycleCount();
+            wheel.spinBatch(pockets);
+            const std::uint64_t t1 = cycleCount();
+            classifyPockets(pockets, classes);
+            const std::uint64_t t2 = cycleCount();
+            for (std::size_t next = 0; next < spinBlock && sessionActive(state); ) {
+                const int safe = std::min(safeSpins(state, rules), static_cast<int>(spinBlock - next));
+                if (safe > 1) { advanceSession(state, rules, pockets + next, classes + next, safe); next += static_cast<std::size_t>(safe); }
+                else { stepSession(state, rules, pockets[next], classes[next]); ++next; }
+            }
+            const std::uint64_t t3 = cycleCount();
+            cycles.add(Stage::RNG, t1 - t0); cycles.add(Stage::CLASSIFY, t2 - t1); cycles.add(Stage::STEP, t3 - t2);
+        }
+        return makeSessionResult(state);
+    }
+
+    // Traced sessions are replayed after the batch from their own streams and under its
+    // accounting; the replay is exact, so the farm itself never pays for tracing
+    template<class Generator, class Layout>
+    void writeTraces(const BatchOptions& opt) const {
+        const bool cents = opt.accounting == Accounting::CENTS;
+        const BasicStrategyParams<CentMoney> centParams = cents ? makeStrategyParams<CentMoney>(config) : BasicStrategyParams<CentMoney>();
+        SpinTraceWriter writer(opt.tracePath);
+        BasicRouletteWheel<Generator, Layout> wheel(opt.masterSeed, 0);
+        for (std::uint64_t i : opt.traceSessions) { // runFarm() checked the indices
+            CounterStatsTracker stats;
+            stats.attachTrace(&writer, opt.firstSession + i);
+            wheel.reseed(opt.masterSeed, opt.firstSession + i);
+            if (cents) playSession(wheel, centParams, stats);
+            else runSession(wheel, stats);
+        }
+        writer.close();
+        if (writer.failed()) throw std::runtime_error("Writing trace file failed: " + opt.tracePath);
+    }
+
+    static constexpr std::size_t spinBlock = 64;    // pockets drawn per spinBatch call
+    static constexpr int laneCount = 8;             // sessions per SessionLanes group
+
+    struct alignas(64) WorkerTotals { // Per-thread counters, padded against false sharing
+        std::uint64_t ruined = 0, spins = 0, maxBetHits = 0, sessionsHittingMaxBet = 0;
+        SessionSketch sketch;
+        void add(const SessionResult& r) {
+            sketch.add(r);
+            ruined += r.ruined ? 1 : 0;
+            spins += static_cast<std::uint64_t>(r.spins);
+            maxBetHits += static_cast<std::uint64_t>(r.maxBetHits);
+            sessionsHittingMaxBet += r.maxBetHits > 0 ? 1 : 0;
+        }
+        void merge(const WorkerTotals& o) {
+            sketch.merge(o.sketch);
+            ruined += o.ruined; spins += o.spins; maxBetHits += o.maxBetHits; sessionsHittingMaxBet += o.sessionsHittingMaxBet;
+        }
+        void addTo(BatchResult& out) const { // counters and sketch; the sums are kept per chunk
+            out.ruined += ruined; out.totalSpins += spins;
+            out.maxBetHits += maxBetHits; out.sessionsHittingMaxBet += sessionsHittingMaxBet;
+            out.distribution.merge(sketch);
+        }
+    };
+    struct PublishedTotals { // A worker's finished chunks, for the snapshot thread
+        std::mutex m;
+        WorkerTotals totals;
+        std::vector<std::uint64_t> chunks;
+    };
+
+    StrategyConfig config;
+    StrategyParams params;
+    StrategyProgram program;              // compiled config.program; unused when it is empty
+};
+
+inline void printBatchResult(const BatchResult& r, std::ostream& os) { // Print aggregate results
+    os << "\n===== Batch Results =====\n"
+        << "Sessions: " << r.sessions << "\n"
+        << "Ruin probability: " << (r.ruinProbability * 100.0) << "% (" << r.ruined << " sessions)\n"
+        << "Mean final bankroll: $" << r.meanFinalBankroll << " (std. error $" << r.meanStdErr << ")\n"
+        << "Final bankroll p5/p25/p50/p75/p95: $" << r.p05 << " / $" << r.p25 << " / $" << r.median
+        << " / $" << r.p75 << " / $" << r.p95 << "\n"
+        << "Max-bet cap hit: " << r.maxBetHits << " times in " << r.sessionsHittingMaxBet << " sessions ("
+        << (r.sessions ? 100.0 * static_cast<double>(r.sessionsHittingMaxBet) / static_cast<double>(r.sessions) : 0.0)
+        << "%)\n"
+        << "Average spins per session: "
+        << (r.sessions ? static_cast<double>(r.totalSpins) / static_cast<double>(r.sessions) : 0.0) << "\n";
+    const LinearHistogram& streaks = r.distribution.longestLossStreak;
+    os << "Longest loss streak p50/p95/max: " << streaks.quantile(0.50) << " / " << streaks.quantile(0.95)
+        << " / " << streaks.max() << "\n";
+    const LinearHistogram& ruin = r.distribution.spinsToRuin;
+    if (ruin.count()) os << "Spins to ruin p50/p95 (mean): " << ruin.quantile(0.50) << " / " << ruin.quantile(0.95)
+        << " (" << ruin.mean() << ")\n";
+    os << "=========================\n";
+}
@@ -0,0 +1,291 @@
+// ============================================================================
+//  SpinBatch.h - bulk spin generation and classification. An 8-lane
+//  xoshiro256++ generator fills pocket buffers with AVX-512, AVX2 or NEON
+//  (scalar fallback), and pocket classes are looked up with byte shuffles.
+//  Every path produces the same stream, so seeded runs do not depend on the ISA.
+//  x86 paths are picked at run time (CpuDispatch.h).
+//  Build:  C++20, Visual Studio 2022 (x64, Windows)
+// ============================================================================
+#pragma once
+
+#include "CpuDispatch.h"
+#include "RouletteCore.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#if defined(ROULETTE_SIMD_AVX512) || defined(ROULETTE_SIMD_AVX2) || defined(ROULETTE_SIMD_SSE42)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+// ============================================================================
+//  Xoshiro256x8 - eight independent xoshiro256++ lanes advanced in lockstep.
+//  One step yields one 64-bit word per lane; a pocket is Lemire's mapping of
+//  the word's high 32 bits. The rare rejected lane is redrawn from that lane
+//  alone, in lane order, identically on every path.
+// ============================================================================
+class Xoshiro256x8 { // Generator policy with a SIMD bulk path
+public:
+    static constexpr int lanes = 8;
+
+    void seed(std::uint64_t masterSeed, std::uint64_t stream) {
+        std::uint64_t sm = deriveStreamSeed(masterSeed, stream);
+        for (int l = 0; l < lanes; ++l)
+            for (int w = 0; w < 4; ++w) s[w][l] = splitMix64(sm);
+        used = lanes;
+    }
+    std::uint32_t next32() { // Scalar interface: hand out one lane word at a time
+        if (used == lanes) { stepAll(); used = 0; }
+        return static_cast<std::uint32_t>(buf[used++] >> 32);
+    }
+    void fillBelow(std::span<std::uint8_t> out, std::uint32_t range) { // Bulk pockets in [0, range), range <= 256
+        used = lanes; // bulk draws start on a fresh step
+        std::size_t i = 0;
+        const std::size_t whole = out.size() - out.size() % lanes;
+        switch (simdLevel()) {
+#if defined(ROULETTE_SIMD_AVX512)
+        case SimdLevel::AVX512: i = fillAvx512(out.data(), whole, range); break;
+#endif
+#if defined(ROULETTE_SIMD_AVX2)
+        case SimdLevel::AVX2: i = fillAvx2(out.data(), whole, range); break;
+#endif
+        default: // SSE4.2 gains nothing over scalar here: no 64-bit rotate, two lanes per register
+#if defined(__ARM_NEON) && defined(__aarch64__)
+            i = fillNeon(out.data(), whole, range);
+#endif
+            break;
+        }
+        for (; i < whole; i += lanes) fillStepScalar(out.data() + i, range);
+        if (i < out.size()) { // ragged tail: one more step, keep what fits
+            std::uint8_t tail[lanes];
+            fillStepScalar(tail, range);
+            for (std::size_t k = 0; i < out.size(); ++i, ++k) out[i] = tail[k];
+        }
+    }
+
+private:
+    static std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    std::uint64_t stepLane(int l) { // Advance one lane
+        const std::uint64_t result = rotl(s[0][l] + s[3][l], 23) + s[0][l];
+        const std::uint64_t t = s[1][l] << 17;
+        s[2][l] ^= s[0][l]; s[3][l] ^= s[1][l]; s[1][l] ^= s[2][l]; s[0][l] ^= s[3][l];
+        s[2][l] ^= t;
+        s[3][l] = rotl(s[3][l], 45);
+        return result;
+    }
+    void stepAll() { for (int l = 0; l < lanes; ++l) buf[l] = stepLane(l); }
+
+    std::uint8_t redrawLane(int l, std::uint32_t range) { // Lemire rejection loop on one lane
+        const std::uint32_t threshold = (0u - range) % range;
+        std::uint64_t m;
+        do { m = (stepLane(l) >> 32) * range; } while (static_cast<std::uint32_t>(m) < threshold);
+        return static_cast<std::uint8_t>(m >> 32);
+    }
+    void fixRejects(std::uint8_t* dst, const std::uint64_t* words, std::uint32_t range) { // Slow path, ~1e-9 per pocket
+        const std::uint32_t threshold = (0u - range) % range;
+        for (int l = 0; l < lanes; ++l) {
+            const std::uint64_t m = (words[l] >> 32) * range;
+            if (static_cast<std::uint32_t>(m) < threshold) dst[l] = redrawLane(l, range);
+        }
+    }
+    void fillStepScalar(std::uint8_t* dst, std::uint32_t range) {
+        bool reject = false;
+        stepAll();
+        for (int l = 0; l < lanes; ++l) {
+            const std::uint64_t m = (buf[l] >> 32) * range;
+            dst[l] = static_cast<std::uint8_t>(m >> 32);
+            reject |= static_cast<std::uint32_t>(m) < range;
+        }
+        if (reject) fixRejects(dst, buf, range);
+    }
+
+#if defined(ROULETTE_SIMD_AVX512)
+    ROULETTE_TARGET("avx512f") std::size_t fillAvx512(std::uint8_t* dst, std::size_t n, std::uint32_t range) {
+        __m512i s0 = _mm512_load_si512(s[0]), s1 = _mm512_load_si512(s[1]);
+        __m512i s2 = _mm512_load_si512(s[2]), s3 = _mm512_load_si512(s[3]);
+        const __m512i r = _mm512_set1_epi64(range), lowMask = _mm512_set1_epi64(0xFFFFFFFFll);
+        std::size_t i = 0;
+        for (; i < n; i += lanes) {
+            const __m512i result = _mm512_add_epi64(_mm512_rol_epi64(_mm512_add_epi64(s0, s3), 23), s0);
+            const __m512i t = _mm512_slli_epi64(s1, 17);
+            s2 = _mm512_xor_si512(s2, s0); s3 = _mm512_xor_si512(s3, s1);
+            s1 = _mm512_xor_si512(s1, s2); s0 = _mm512_xor_si512(s0, s3);
+            s2 = _mm512_xor_si512(s2, t);
+            s3 = _mm512_rol_epi64(s3, 45);
+            const __m512i m = _mm512_mul_epu32(_mm512_srli_epi64(result, 32), r);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), _mm512_cvtepi64_epi8(_mm512_srli_epi64(m, 32)));
+            if (_mm512_cmplt_epu64_mask(_mm512_and_si512(m, lowMask), r)) { // possible reject: finish in memory
+                alignas(64) std::uint64_t words[lanes];
+                _mm512_store_si512(words, result);
+                _mm512_store_si512(s[0], s0); _mm512_store_si512(s[1], s1);
+                _mm512_store_si512(s[2], s2); _mm512_store_si512(s[3], s3);
+                fixRejects(dst + i, words, range);
+                s0 = _mm512_load_si512(s[0]); s1 = _mm512_load_si512(s[1]);
+                s2 = _mm512_load_si512(s[2]); s3 = _mm512_load_si512(s[3]);
+            }
+        }
+        _mm512_store_si512(s[0], s0); _mm512_store_si512(s[1], s1);
+        _mm512_store_si512(s[2], s2); _mm512_store_si512(s[3], s3);
+        return i;
+    }
+#endif
+#if defined(ROULETTE_SIMD_AVX2)
+    ROULETTE_TARGET("avx2") static __m256i rotl256(__m256i x, int k) { return _mm256_or_si256(_mm256_slli_epi64(x, k), _mm256_srli_epi64(x, 64 - k)); }
+
+    ROULETTE_TARGET("avx2") std::size_t fillAvx2(std::uint8_t* dst, std::size_t n, std::uint32_t range) {
+        const __m256i r = _mm256_set1_epi64x(range);
+        const __m256i rangeMinus1 = _mm256_set1_epi32(static_cast<int>(range - 1));
+        const __m256i oddDwords = _mm256_setr_epi32(1, 3, 5, 7, 0, 0, 0, 0);
+        std::size_t i = 0;
+        for (; i < n; i += lanes) {
+            __m256i m[2], result[2];
+            for (int h = 0; h < 2; ++h) { // lanes 0-3, then 4-7
+                __m256i* p0 = reinterpret_cast<__m256i*>(s[0] + 4 * h);
+                __m256i* p1 = reinterpret_cast<__m256i*>(s[1] + 4 * h);
+                __m256i* p2 = reinterpret_cast<__m256i*>(s[2] + 4 * h);
+                __m256i* p3 = reinterpret_cast<__m256i*>(s[3] + 4 * h);
+                __m256i s0 = _mm256_load_si256(p0), s1 = _mm256_load_si256(p1);
+                __m256i s2 = _mm256_load_si256(p2), s3 = _mm256_load_si256(p3);
+                result[h] = _mm256_add_epi64(rotl256(_mm256_add_epi64(s0, s3), 23), s0);
+                const __m256i t = _mm256_slli_epi64(s1, 17);
+                s2 = _mm256_xor_si256(s2, s0); s3 = _mm256_xor_si256(s3, s1);
+                s1 = _mm256_xor_si256(s1, s2); s0 = _mm256_xor_si256(s0, s3);
+                s2 = _mm256_xor_si256(s2, t);
+                s3 = rotl256(s3, 45);
+                _mm256_store_si256(p0, s0); _mm256_store_si256(p1, s1);
+                _mm256_store_si256(p2, s2); _mm256_store_si256(p3, s3);
+                m[h] = _mm256_mul_epu32(_mm256_srli_epi64(result[h], 32), r);
+            }
+            // Pockets sit in the odd dwords of m; gather them and narrow to bytes
+            const __m128i lo = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(m[0], oddDwords));
+            const __m128i hi = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(m[1], oddDwords));
+            const __m128i words16 = _mm_packus_epi32(lo, hi);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(words16, words16));
+            // low dword < range  <=>  min(low, range - 1) == low; only even dwords count
+            const __m256i le0 = _mm256_cmpeq_epi32(_mm256_min_epu32(m[0], rangeMinus1), m[0]);
+            const __m256i le1 = _mm256_cmpeq_epi32(_mm256_min_epu32(m[1], rangeMinus1), m[1]);
+            const int mask = (_mm256_movemask_ps(_mm256_castsi256_ps(le0)) | _mm256_movemask_ps(_mm256_castsi256_ps(le1))) & 0x55;
+            if (mask) { // possible reject
+                alignas(32) std::uint64_t words[lanes];
+                _mm256_store_si256(reinterpret_cast<__m256i*>(words), result[0]);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(words + 4), result[1]);
+                fixRejects(dst + i, words, range);
+            }
+        }
+        return i;
+    }
+#endif
+#if defined(__ARM_NEON) && defined(__aarch64__)
+    template<int K>
+    static uint64x2_t rotlNeon(uint64x2_t x) { return vorrq_u64(vshlq_n_u64(x, K), vshrq_n_u64(x, 64 - K)); }
+
+    std::size_t fillNeon(std::uint8_t* dst, std::size_t n, std::uint32_t range) {
+        const uint32x2_t r = vdup_n_u32(range);
+        std::size_t i = 0;
+        for (; i < n; i += lanes) {
+            alignas(16) std::uint64_t words[lanes];
+            bool reject = false;
+            for (int q = 0; q < lanes; q += 2) { // two lanes per register
+                uint64x2_t s0 = vld1q_u64(s[0] + q), s1 = vld1q_u64(s[1] + q);
+                uint64x2_t s2 = vld1q_u64(s[2] + q), s3 = vld1q_u64(s[3] + q);
+                const uint64x2_t result = vaddq_u64(rotlNeon<23>(vaddq_u64(s0, s3)), s0);
+                const uint64x2_t t = vshlq_n_u64(s1, 17);
+                s2 = veorq_u64(s2, s0); s3 = veorq_u64(s3, s1);
+                s1 = veorq_u64(s1, s2); s0 = veorq_u64(s0, s3);
+                s2 = veorq_u64(s2, t);
+                s3 = rotlNeon<45>(s3);
+                vst1q_u64(s[0] + q, s0); vst1q_u64(s[1] + q, s1);
+                vst1q_u64(s[2] + q, s2); vst1q_u64(s[3] + q, s3);
+                vst1q_u64(words + q, result);
+                const uint64x2_t m = vmull_u32(vshrn_n_u64(result, 32), r);
+                const uint32x2_t pocket = vshrn_n_u64(m, 32);
+                const uint32x2_t low = vmovn_u64(m);
+                dst[i + q] = static_cast<std::uint8_t>(vget_lane_u32(pocket, 0));
+                dst[i + q + 1] = static_cast<std::uint8_t>(vget_lane_u32(pocket, 1));
+                reject |= vmaxv_u32(vclt_u32(low, r)) != 0;
+            }
+            if (reject) fixRejects(dst + i, words, range);
+        }
+        return i;
+    }
+#endif
+
+    alignas(64) std::uint64_t s[4][lanes]{}; // word-major so each state word is one vector
+    std::uint64_t buf[lanes]{};
+    int used = lanes;
+};
+
+// ============================================================================
+//  classifyPockets - pocket index -> class bits (pocketRed, pocketBlack, ...).
+//  The 48-byte class table is split into three 16-byte rows and selected with
+//  byte shuffles: 32 pockets per AVX2 iteration, 16 per SSE4.2 iteration or
+//  per NEON table lookup. Each path returns how many pockets it classified.
+// ============================================================================
+#if defined(ROULETTE_SIMD_AVX2)
+ROULETTE_TARGET("avx2") inline std::size_t classifyAvx2(const std::uint8_t* pockets, std::uint8_t* classes, std::size_t n) {
+    const __m256i row0 = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pocketClassTable.data())));
+    const __m256i row1 = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pocketClassTable.data() + 16)));
+    const __m256i row2 = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pocketClassTable.data() + 32)));
+    const __m256i nibble = _mm256_set1_epi8(0x0F), one = _mm256_set1_epi8(1), two = _mm256_set1_epi8(2);
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pockets + i));
+        const __m256i lowNibble = _mm256_and_si256(idx, nibble);
+        const __m256i row = _mm256_and_si256(_mm256_srli_epi16(idx, 4), nibble);
+        __m256i out = _mm256_shuffle_epi8(row0, lowNibble);
+        out = _mm256_blendv_epi8(out, _mm256_shuffle_epi8(row1, lowNibble), _mm256_cmpeq_epi8(row, one));
+        out = _mm256_blendv_epi8(out, _mm256_shuffle_epi8(row2, lowNibble), _mm256_cmpeq_epi8(row, two));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(classes + i), out);
+    }
+    return i;
+}
+#endif
+#if defined(ROULETTE_SIMD_SSE42)
+ROULETTE_TARGET("sse4.2") inline std::size_t classifySse42(const std::uint8_t* pockets, std::uint8_t* classes, std::size_t n) {
+    const __m128i row0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pocketClassTable.data()));
+    const __m128i row1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pocketClassTable.data() + 16));
+    const __m128i row2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pocketClassTable.data() + 32));
+    const __m128i nibble = _mm_set1_epi8(0x0F), one = _mm_set1_epi8(1), two = _mm_set1_epi8(2);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i idx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pockets + i));
+        const __m128i lowNibble = _mm_and_si128(idx, nibble);
+        const __m128i row = _mm_and_si128(_mm_srli_epi16(idx, 4), nibble);
+        __m128i out = _mm_shuffle_epi8(row0, lowNibble);
+        out = _mm_blendv_epi8(out, _mm_shuffle_epi8(row1, lowNibble), _mm_cmpeq_epi8(row, one));
+        out = _mm_blendv_epi8(out, _mm_shuffle_epi8(row2, lowNibble), _mm_cmpeq_epi8(row, two));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(classes + i), out);
+    }
+    return i;
+}
+#endif
+
+inline void classifyPockets(std::span<const std::uint8_t> pockets, std::span<std::uint8_t> classes) {
+    const std::size_t n = pockets.size() < classes.size() ? pockets.size() : classes.size();
+    std::size_t i = 0;
+    switch (simdLevel()) {
+#if defined(ROULETTE_SIMD_AVX2)
+    case SimdLevel::AVX512: case SimdLevel::AVX2: i = classifyAvx2(pockets.data(), classes.data(), n); break;
+#endif
+#if defined(ROULETTE_SIMD_SSE42)
+    case SimdLevel::SSE42: i = classifySse42(pockets.data(), classes.data(), n); break;
+#endif
+    default:
+#if defined(__ARM_NEON) && defined(__aarch64__)
+        {
+            uint8x16x3_t table;
+            table.val[0] = vld1q_u8(pocketClassTable.data());
+            table.val[1] = vld1q_u8(pocketClassTable.data() + 16);
+            table.val[2] = vld1q_u8(pocketClassTable.data() + 32);
+            for (; i + 16 <= n; i += 16)
+                vst1q_u8(classes.data() + i, vqtbl3q_u8(table, vld1q_u8(pockets.data() + i)));
+        }
+#endif
+        break;
+    }
+    for (; i < n; ++i) classes[i] = pocketClassTable[pockets[i]];
+}
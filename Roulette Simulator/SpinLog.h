@@ -0,0 +1,363 @@
+// ============================================================================
+//  SpinLog.h - packed binary spin logs. A log is one RNG stream's pocket
+//  sequence, three pockets per 16-bit word in base `pockets` (39^3 = 59319
+//  < 65536 for the largest wheel), behind a fixed header naming the seed,
+//  stream, generator and wheel. Logs are read
+//  through a memory mapping and decoded in blocks straight into the kernel's
+//  pocket buffers; 10^9 spins take 667 MB. Scripted runs write and play
+//  them with mode = record and mode = replay (JobRunner.h).
+//  Build:  C++20, Visual Studio 2022 (x64, Windows)
+// ============================================================================
+#pragma once
+
+#include "RouletteCore.h"
+#include "SimulationEngine.h"
+#include "SpinBatch.h"
+#include "StrategyKernel.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static_assert(std::endian::native == std::endian::little, "spin logs are stored little-endian");
+
+struct SpinLogHeader { // 40 bytes at offset 0; the packed words follow
+    static constexpr std::uint32_t expectedMagic = 0x4C505352u; // "RSPL"
+    static constexpr std::uint16_t currentVersion = 1;
+
+    std::uint32_t magic = expectedMagic;
+    std::uint16_t version = currentVersion;
+    std::uint16_t pockets = AmericanLayout::pockets; // wheel type: 37 European, 38 American, 39 triple zero
+    std::uint16_t generator = 0;              // GeneratorKind that produced the stream
+    std::uint16_t spinsPerWord = 3;
+    std::uint32_t reserved = 0;
+    std::uint64_t masterSeed = 0;
+    std::uint64_t stream = 0;                 // stream index, as in deriveStreamSeed()
+    std::uint64_t spins = 0;                  // pockets stored; the last word may be part-filled
+};
+static_assert(sizeof(SpinLogHeader) == 40, "SpinLogHeader is a file format");
+
+constexpr std::uint16_t packSpins(std::uint8_t a, std::uint8_t b, std::uint8_t c, unsigned pockets) { // Three pockets, first in the low digit
+    return static_cast<std::uint16_t>(a + pockets * (b + pockets * c));
+}
+
+// Decode `words` into 3 * words.size() pockets. Division by the constant becomes a multiply,
+// so this is a few instructions per word; the reader validated the words when it opened the log.
+template<unsigned Pockets>
+void unpackSpins(std::span<const std::uint16_t> words, std::uint8_t* out) {
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        const unsigned w = words[i], q = w / Pockets;
+        out[3 * i] = static_cast<std::uint8_t>(w - q * Pockets);
+        out[3 * i + 1] = static_cast<std::uint8_t>(q % Pockets);
+        out[3 * i + 2] = static_cast<std::uint8_t>(q / Pockets);
+    }
+}
+
+inline WheelKind spinLogWheel(std::uint16_t pockets) { // Header pocket count to wheel kind; throws for other wheels
+    switch (pockets) {
+    case EuropeanLayout::pockets: return WheelKind::EUROPEAN;
+    case AmericanLayout::pockets: return WheelKind::AMERICAN;
+    case TripleZeroLayout::pockets: return WheelKind::TRIPLE_ZERO;
+    default: throw std::runtime_error("Spin log is for an unknown wheel");
+    }
+}
+
+// ============================================================================
+//  SpinLogWriter
+//  Appends pockets, buffering whole words; close() (or the destructor) flushes
+//  the final partial word and rewrites the header with the spin count.
+// ============================================================================
+class SpinLogWriter { // Packed spin-log output
+public:
+    SpinLogWriter(const std::string& path, SpinLogHeader h) : file(path, std::ios::binary | std::ios::trunc), header(h) {
+        if (!file) throw std::runtime_error("Cannot create spin log: " + path);
+        header.spins = 0;
+        writeHeader();
+        words.reserve(bufferWords);
+    }
+    SpinLogWriter(const SpinLogWriter&) = delete;
+    SpinLogWriter& operator=(const SpinLogWriter&) = delete;
+    ~SpinLogWriter() { try { close(); } catch (...) {} }
+
+    void append(std::span<const std::uint8_t> pockets) {
+        for (std::uint8_t p : pockets) {
+            carry[carried++] = p;
+            if (carried == 3) {
+                words.push_back(packSpins(carry[0], carry[1], carry[2], header.pockets));
+                carried = 0;
+                if (words.size() == bufferWords) flushWords();
+            }
+        }
+        header.spins += pockets.size();
+    }
+    std::uint64_t spins() const { return header.spins; }
+
+    void close() {
+        if (!file.is_open()) return;
+        if (carried) { // pad the last word with pocket 0
+            words.push_back(packSpins(carry[0], carried > 1 ? carry[1] : 0, 0, header.pockets));
+            carried = 0;
+        }
+        flushWords();
+        file.seekp(0);
+        writeHeader();
+        file.close();
+        if (file.fail()) throw std::runtime_error("Writing spin log failed");
+    }
+
+private:
+    void writeHeader() { file.write(reinterpret_cast<const char*>(&header), sizeof header); }
+    void flushWords() {
+        file.write(reinterpret_cast<const char*>(words.data()), static_cast<std::streamsize>(words.size() * sizeof(std::uint16_t)));
+        words.clear();
+        if (!file) throw std::runtime_error("Writing spin log failed");
+    }
+
+    static constexpr std::size_t bufferWords = 32 * 1024;
+    std::ofstream file;
+    SpinLogHeader header;
+    std::vector<std::uint16_t> words;
+    std::uint8_t carry[3] = {};
+    int carried = 0;
+};
+
+// Record `spins` pockets of stream (masterSeed, stream), drawn in the same 64-spin
+// blocks as SimulationEngine::runSession(), so replaying the log reproduces that session
+template<class Generator, class Layout>
+std::uint64_t recordSpinLog(const std::string& path, std::uint64_t masterSeed, std::uint64_t stream, std::uint64_t spins, GeneratorKind kind) {
+    SpinLogHeader h;
+    h.pockets = Layout::pockets;
+    h.generator = static_cast<std::uint16_t>(kind); h.masterSeed = masterSeed; h.stream = stream;
+    SpinLogWriter writer(path, h);
+    BasicRouletteWheel<Generator, Layout> wheel(masterSeed, stream);
+    std::uint8_t block[64];
+    for (std::uint64_t done = 0; done < spins; done += sizeof block) {
+        wheel.spinBatch(block);
+        writer.append(std::span<const std::uint8_t>(block, static_cast<std::size_t>(std::min<std::uint64_t>(sizeof block, spins - done))));
+    }
+    writer.close();
+    return writer.spins();
+}
+inline std::uint64_t recordSpinLog(const std::string& path, GeneratorKind kind, std::uint64_t masterSeed, std::uint64_t stream, std::uint64_t spins,
+    WheelKind wheel = WheelKind::AMERICAN) {
+    return withWheelLayout(wheel, [&](auto layout) { // dispatch once, as SimulationEngine::run does
+        using Layout = decltype(layout);
+        switch (kind) {
+        case GeneratorKind::XOSHIRO256PP: return recordSpinLog<Xoshiro256PlusPlus, Layout>(path, masterSeed, stream, spins, kind);
+        case GeneratorKind::PHILOX4X32: return recordSpinLog<Philox4x32, Layout>(path, masterSeed, stream, spins, kind);
+        case GeneratorKind::MT19937: return recordSpinLog<Mt19937Generator, Layout>(path, masterSeed, stream, spins, kind);
+        default: return recordSpinLog<Xoshiro256x8, Layout>(path, masterSeed, stream, spins, GeneratorKind::XOSHIRO256X8);
+        }
+    });
+}
+
+// ============================================================================
+//  MappedFile - read-only mapping of a whole file (CreateFileMapping on
+//  Windows, mmap elsewhere)
+// ============================================================================
+class MappedFile { // RAII read-only file mapping
+public:
+    explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+        file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("Cannot open spin log: " + path);
+        LARGE_INTEGER sz{};
+        if (!::GetFileSizeEx(file, &sz)) { release(); throw std::runtime_error("Cannot size spin log: " + path); }
+        length = static_cast<std::size_t>(sz.QuadPart);
+        if (length) {
+            mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping) bytes = static_cast<const std::uint8_t*>(::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            if (!bytes) { release(); throw std::runtime_error("Cannot map spin log: " + path); }
+        }
+#else
+        fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("Cannot open spin log: " + path);
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) { release(); throw std::runtime_error("Cannot size spin log: " + path); }
+        length = static_cast<std::size_t>(st.st_size);
+        if (length) {
+            void* p = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) { release(); throw std::runtime_error("Cannot map spin log: " + path); }
+            bytes = static_cast<const std::uint8_t*>(p);
+            ::madvise(p, length, MADV_SEQUENTIAL); // replay reads front to back
+        }
+#endif
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { release(); }
+
+    const std::uint8_t* data() const { return bytes; }
+    std::size_t size() const { return length; }
+
+private:
+    void release() {
+#ifdef _WIN32
+        if (bytes) ::UnmapViewOfFile(bytes);
+        if (mapping) ::CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) ::CloseHandle(file);
+        mapping = nullptr; file = INVALID_HANDLE_VALUE;
+#else
+        if (bytes) ::munmap(const_cast<std::uint8_t*>(bytes), length);
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+#endif
+        bytes = nullptr;
+    }
+
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE, mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+    const std::uint8_t* bytes = nullptr;
+    std::size_t length = 0;
+};
+
+// ============================================================================
+//  SpinLogReader
+//  Maps a log and checks it once on open: header fields, file length, and that
+//  every word holds three valid pockets. After that, decoding is unchecked.
+// ============================================================================
+class SpinLogReader { // Memory-mapped spin log
+public:
+    explicit SpinLogReader(const std::string& path) : map(path) {
+        if (map.size() < sizeof(SpinLogHeader)) throw std::runtime_error("Not a spin log: " + path);
+        std::memcpy(&head, map.data(), sizeof head);
+        if (head.magic != SpinLogHeader::expectedMagic) throw std::runtime_error("Not a spin log: " + path);
+        if (head.version != SpinLogHeader::currentVersion || head.spinsPerWord != 3)
+            throw std::runtime_error("Unsupported spin log version: " + path);
+        if (head.pockets < EuropeanLayout::pockets || head.pockets > TripleZeroLayout::pockets)
+            throw std::runtime_error("Spin log is for an unknown wheel: " + path);
+        wheelKind = spinLogWheel(head.pockets);
+        const std::uint64_t wordCount = (head.spins + 2) / 3;
+        if ((map.size() - sizeof(SpinLogHeader)) / sizeof(std::uint16_t) < wordCount) throw std::runtime_error("Spin log is truncated: " + path);
+        packed = std::span<const std::uint16_t>(reinterpret_cast<const std::uint16_t*>(map.data() + sizeof(SpinLogHeader)),
+            static_cast<std::size_t>(wordCount));
+        const unsigned limit = static_cast<unsigned>(head.pockets) * head.pockets * head.pockets;
+        if (std::any_of(packed.begin(), packed.end(), [limit](std::uint16_t w) { return w >= limit; }))
+            throw std::runtime_error("Spin log is corrupt: " + path);
+    }
+
+    const SpinLogHeader& header() const { return head; }
+    WheelKind wheel() const { return wheelKind; }
+    std::uint64_t spins() const { return head.spins; }
+    std::span<const std::uint16_t> words() const { return packed; }
+
+    // Decode pockets [3 * firstWord, 3 * (firstWord + out.size() / 3)) into out; returns pockets written
+    std::size_t decode(std::size_t firstWord, std::span<std::uint8_t> out) const {
+        if (firstWord >= packed.size()) return 0;
+        const std::size_t n = std::min(out.size() / 3, packed.size() - firstWord);
+        const auto words = packed.subspan(firstWord, n);
+        switch (wheelKind) { // per block, so each wheel keeps its constant divisor
+        case WheelKind::EUROPEAN: unpackSpins<EuropeanLayout::pockets>(words, out.data()); break;
+        case WheelKind::TRIPLE_ZERO: unpackSpins<TripleZeroLayout::pockets>(words, out.data()); break;
+        default: unpackSpins<AmericanLayout::pockets>(words, out.data()); break;
+        }
+        return static_cast<std::size_t>(std::min<std::uint64_t>(3 * n, head.spins - 3 * static_cast<std::uint64_t>(firstWord)));
+    }
+
+private:
+    MappedFile map;
+    SpinLogHeader head;
+    WheelKind wheelKind = WheelKind::AMERICAN;
+    std::span<const std::uint16_t> packed;
+};
+
+// ============================================================================
+//  SpinLogWheel - a wheel that plays back a log, so anything templated on the
+//  wheel (SimulationEngine::runSession, the interactive loop) can replay it
+// ============================================================================
+class SpinLogWheel { // Log playback as a wheel
+public:
+    explicit SpinLogWheel(const SpinLogReader& r) : log(r) {}
+
+    RouletteOutcome spin() { return outcomeTable[spinIndex()]; }
+    std::uint8_t spinIndex() { std::uint8_t p; spinBatch(std::span<std::uint8_t>(&p, 1)); return p; }
+    void spinBatch(std::span<std::uint8_t> out) {
+        for (std::size_t done = 0; done < out.size(); ) {
+            if (next == filled) refill();
+            const std::size_t n = std::min(out.size() - done, filled - next);
+            std::memcpy(out.data() + done, buffer + next, n);
+            next += n; done += n;
+        }
+    }
+    std::uint64_t position() const { return consumed - (filled - next); } // pockets handed out so far
+    std::uint64_t remaining() const { return log.spins() - position(); }
+
+private:
+    void refill() {
+        filled = log.decode(word, buffer);
+        if (filled == 0) throw std::out_of_range("Spin log exhausted");
+        word += blockWords; consumed += filled; next = 0;
+    }
+
+    static constexpr std::size_t blockWords = 64;
+    const SpinLogReader& log;
+    std::uint8_t buffer[3 * blockWords];
+    std::size_t word = 0, next = 0, filled = 0;
+    std::uint64_t consumed = 0;
+};
+
+// Play the log as back-to-back sessions of one strategy, each starting on the spin after the
+// previous one ended; onDone(SessionResult) is called per complete session. Returns that count.
+// The configuration must name the log's wheel, since the extra bet pays by its zeros.
+template<class OnDone>
+std::uint64_t replaySessions(const SpinLogReader& log, const StrategyConfig& config, OnDone&& onDone) {
+    if (config.wheel != log.wheel()) throw std::invalid_argument("Spin log was recorded on a different wheel");
+    requireBuiltInRules(config, "Spin-log replay");
+    const StrategyParams params = makeStrategyParams(config);
+    constexpr std::size_t blockWords = 1024;
+    std::vector<std::uint8_t> pockets(3 * blockWords), classes(3 * blockWords);
+    SessionState state = startSession(params);
+    std::uint64_t sessions = 0;
+    for (std::size_t word = 0, n; (n = log.decode(word, pockets)) > 0; word += blockWords) {
+        classifyPockets(std::span<const std::uint8_t>(pockets.data(), n), std::span<std::uint8_t>(classes.data(), n));
+        for (std::size_t i = 0; i < n; ++i) {
+            if (!sessionActive(state)) break; // a session that cannot open ends the replay
+            stepSession(state, params, pockets[i], classes[i]);
+            if (!sessionActive(state)) {
+                onDone(makeSessionResult(state));
+                ++sessions;
+                state = startSession(params);
+            }
+        }
+        if (!sessionActive(state)) break;
+    }
+    return sessions;
+}
+
+// The same replay summed into a batch report, so a log can be compared with a live run
+inline BatchResult replayBatch(const SpinLogReader& log, const StrategyConfig& config) {
+    BatchResult out;
+    replaySessions(log, config, [&](const SessionResult& r) {
+        ++out.sessions;
+        out.ruined += r.ruined ? 1 : 0;
+        out.totalSpins += static_cast<std::uint64_t>(r.spins);
+        out.maxBetHits += static_cast<std::uint64_t>(r.maxBetHits);
+        out.sessionsHittingMaxBet += r.maxBetHits > 0 ? 1 : 0;
+        out.finalSum += r.finalBankroll; out.finalSumSq += r.finalBankroll * r.finalBankroll;
+        out.distribution.add(r);
+    });
+    finishBatchResult(out);
+    return out;
+}
@@ -0,0 +1,144 @@
+// ============================================================================
+//  SpinTrace.h - per-spin trace export. Spins are appended column-wise into
+//  fixed-size chunks from a small preallocated pool; full chunks are handed
+//  to a background thread that formats them as CSV and writes them out. The
+//  writer's memory is the pool, whatever the number or length of sessions.
+//  Build:  C++20, Visual Studio 2022 (x64, Windows)
+// ============================================================================
+#pragma once
+
+#include "RouletteCore.h"
+
+#include <array>
+#include <charconv>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct TraceRow { // One spin as the tracker sees it
+    std::uint64_t session = 0;
+    int spin = 0;                         // 1-based within the session
+    std::uint8_t pocket = 0;
+    double wager = 0.0, net = 0.0;        // main bet placed, bankroll change
+    double bankroll = 0.0, nextBet = 0.0; // after the spin
+    bool won = false, switchedColor = false, capHit = false;
+};
+
+// ============================================================================
+//  SpinTraceWriter
+//  The simulation thread only copies fields into the current chunk. It waits
+//  only when every chunk in the pool is queued for writing, i.e. when the disk
+//  has fallen a whole pool behind; stalls() counts those waits.
+// ============================================================================
+class SpinTraceWriter { // Columnar trace buffer with an asynchronous CSV flush
+public:
+    static constexpr std::size_t chunkRows = 4096;
+
+    explicit SpinTraceWriter(const std::string& path, std::size_t poolChunks = 4) : file(path, std::ios::binary | std::ios::trunc) {
+        if (!file) throw std::runtime_error("Cannot create trace file: " + path);
+        file << "session,spin,pocket,color,wager,net,bankroll,next_bet,won,switched,cap_hit\n";
+        pool.resize(poolChunks < 2 ? 2 : poolChunks);
+        for (auto& c : pool) { c = std::make_unique<Chunk>(); spare.push_back(c.get()); }
+        current = spare.front(); spare.pop_front();
+        io = std::thread([this] { writeLoop(); });
+    }
+    SpinTraceWriter(const SpinTraceWriter&) = delete;
+    SpinTraceWriter& operator=(const SpinTraceWriter&) = delete;
+    ~SpinTraceWriter() { close(); }
+
+    void append(const TraceRow& r) {
+        Chunk& c = *current;
+        const std::size_t i = c.rows;
+        c.session[i] = r.session; c.spin[i] = r.spin; c.pocket[i] = r.pocket;
+        c.wager[i] = r.wager; c.net[i] = r.net; c.bankroll[i] = r.bankroll; c.nextBet[i] = r.nextBet;
+        c.flags[i] = static_cast<std::uint8_t>((r.won ? 1 : 0) | (r.switchedColor ? 2 : 0) | (r.capHit ? 4 : 0));
+        if (++c.rows == chunkRows) submit();
+        ++rowCount;
+    }
+
+    void close() { // Flush the partial chunk and stop the I/O thread; safe to call twice
+        if (!io.joinable()) return;
+        if (current->rows) submit();
+        { std::lock_guard<std::mutex> lock(m); stopping = true; }
+        ready.notify_one();
+        io.join();
+        file.close();
+    }
+
+    std::uint64_t rows() const { return rowCount; }
+    std::uint64_t stalls() const { return stallCount; }
+    bool failed() const { return writeFailed; } // valid after close()
+
+private:
+    struct Chunk { // Structure of arrays, one entry per spin
+        std::array<std::uint64_t, chunkRows> session;
+        std::array<int, chunkRows> spin;
+        std::array<std::uint8_t, chunkRows> pocket, flags; // flags: 1 won, 2 switched color, 4 cap hit
+        std::array<double, chunkRows> wager, net, bankroll, nextBet;
+        std::size_t rows = 0;
+    };
+
+    void submit() { // Queue the current chunk and take a free one
+        std::unique_lock<std::mutex> lock(m);
+        full.push_back(current);
+        ready.notify_one();
+        if (spare.empty()) { ++stallCount; freed.wait(lock, [this] { return !spare.empty(); }); }
+        current = spare.front(); spare.pop_front();
+    }
+
+    void writeLoop() { // I/O thread: format and write chunks in submission order
+        std::string text;
+        text.reserve(chunkRows * 64);
+        for (;;) {
+            Chunk* c;
+            {
+                std::unique_lock<std::mutex> lock(m);
+                ready.wait(lock, [this] { return stopping || !full.empty(); });
+                if (full.empty()) return;
+                c = full.front(); full.pop_front();
+            }
+            text.clear();
+            for (std::size_t i = 0; i < c->rows; ++i) formatRow(*c, i, text);
+            file.write(text.data(), static_cast<std::streamsize>(text.size()));
+            if (!file) writeFailed = true;
+            c->rows = 0;
+            { std::lock_guard<std::mutex> lock(m); spare.push_back(c); }
+            freed.notify_one();
+        }
+    }
+
+    static void formatRow(const Chunk& c, std::size_t i, std::string& out) { // to_chars: no locale, no allocation once warm
+        char buf[256], *p = buf, *end = buf + sizeof buf;
+        auto num = [&](auto v) { p = std::to_chars(p, end - 1, v).ptr; *p++ = ','; }; // room for the comma
+        num(c.session[i]); num(c.spin[i]);
+        auto text = [&](const char* t) { while (*t) *p++ = *t++; *p++ = ','; };
+        static constexpr const char* colorNames[] = { "Red", "Black", "Green" }; // Color order; same text as colorToString()
+        const RouletteOutcome& o = outcomeTable[c.pocket[i]];
+        if (o.number < 37) num(o.number); // numberToString() without its std::string
+        else text(o.number == 37 ? "00" : "000");
+        text(colorNames[static_cast<int>(o.color)]);
+        num(c.wager[i]); num(c.net[i]); num(c.bankroll[i]); num(c.nextBet[i]);
+        *p++ = (c.flags[i] & 1) ? '1' : '0'; *p++ = ',';
+        *p++ = (c.flags[i] & 2) ? '1' : '0'; *p++ = ',';
+        *p++ = (c.flags[i] & 4) ? '1' : '0'; *p++ = '\n';
+        out.append(buf, static_cast<std::size_t>(p - buf));
+    }
+
+    std::ofstream file;
+    std::vector<std::unique_ptr<Chunk>> pool;
+    std::deque<Chunk*> spare, full;       // never longer than the pool
+    Chunk* current = nullptr;
+    std::mutex m;
+    std::condition_variable ready, freed;
+    bool stopping = false, writeFailed = false;
+    std::uint64_t rowCount = 0, stallCount = 0;
+    std::thread io;
+};
@@ -0,0 +1,167 @@
+// ============================================================================
+//  StatsSketch.h - fixed-precision streaming summaries for batch results.
+//  Histograms count sessions into buckets instead of keeping every value, so
+//  memory grows with the value range, not the session count, and quantiles
+//  need no sort. Counts are integers: merging per-thread sketches gives the
+//  same result in any order.
+//  Build:  C++20, Visual Studio 2022 (x64, Windows)
+// ============================================================================
+#pragma once
+
+#include "StrategyKernel.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+// ============================================================================
+//  LogHistogram
+//  Log-linear buckets over |value|, one set per sign (HDR histogram layout):
+//  magnitudes below 2 * subCount get a bucket each, above that every power of
+//  two is split into subCount buckets. Each bucket also keeps the smallest
+//  value it has seen, which is what a quantile reports: exact whenever the
+//  bucket holds one distinct value (bankrolls are usually round), and never
+//  off by more than the bucket width, 1/128 of the value.
+// ============================================================================
+class LogHistogram { // Signed log-bucketed histogram
+public:
+    static constexpr int subBits = 7;
+    static constexpr std::uint64_t subCount = 1ull << subBits;
+
+    void add(double v) {
+        Side& side = v < 0 ? negative : positive;
+        const std::size_t i = indexOf(magnitude(v));
+        if (i >= side.counts.size()) side.grow(i + 1); // once per new order of magnitude
+        side.lows[i] = side.counts[i]++ ? std::min(side.lows[i], v) : v;
+        if (total++ == 0) lo = hi = v;
+        else { lo = std::min(lo, v); hi = std::max(hi, v); }
+    }
+    void merge(const LogHistogram& o) {
+        if (o.total == 0) return;
+        negative.merge(o.negative); positive.merge(o.positive);
+        lo = total ? std::min(lo, o.lo) : o.lo; hi = total ? std::max(hi, o.hi) : o.hi;
+        total += o.total;
+    }
+
+    std::uint64_t count() const { return total; }
+    double min() const { return lo; }
+    double max() const { return hi; }
+
+    double quantile(double p) const { // Nearest rank, most negative first
+        if (total == 0) return 0.0;
+        const std::uint64_t rank = rankOf(p, total);
+        std::uint64_t seen = 0;
+        for (std::size_t i = negative.counts.size(); i-- > 0; )
+            if ((seen += negative.counts[i]) >= rank) return negative.lows[i];
+        for (std::size_t i = 0; i < positive.counts.size(); ++i)
+            if ((seen += positive.counts[i]) >= rank) return positive.lows[i];
+        return hi;
+    }
+
+    template<class Archive>
+    void transfer(Archive& ar) { // Buckets and bounds, for sending a sketch between processes (Wire.h)
+        ar(negative.counts); ar(negative.lows); ar(positive.counts); ar(positive.lows); ar(total); ar(lo); ar(hi);
+        if (negative.counts.size() != negative.lows.size() || positive.counts.size() != positive.lows.size())
+            throw std::runtime_error("Malformed histogram");
+    }
+
+    static std::uint64_t rankOf(double p, std::uint64_t n) { // 1-based nearest rank, as the sorted path used
+        const std::uint64_t r = static_cast<std::uint64_t>(std::ceil(p * static_cast<double>(n)));
+        return std::min(n, std::max<std::uint64_t>(r, 1));
+    }
+
+private:
+    struct Side { // Buckets for one sign
+        std::vector<std::uint64_t> counts;
+        std::vector<double> lows;         // smallest value in each non-empty bucket
+        void grow(std::size_t n) { counts.resize(n); lows.resize(n); }
+        void merge(const Side& o) {
+            if (o.counts.size() > counts.size()) grow(o.counts.size());
+            for (std::size_t i = 0; i < o.counts.size(); ++i) {
+                if (!o.counts[i]) continue;
+                lows[i] = counts[i] ? std::min(lows[i], o.lows[i]) : o.lows[i];
+                counts[i] += o.counts[i];
+            }
+        }
+    };
+
+    static std::uint64_t magnitude(double v) {
+        const double m = std::fabs(v);
+        return m >= 0x1p62 ? (1ull << 62) : static_cast<std::uint64_t>(m);
+    }
+    static std::size_t indexOf(std::uint64_t m) {
+        if (m < 2 * subCount) return static_cast<std::size_t>(m);
+        const int shift = std::bit_width(m) - (subBits + 1); // m >> shift lands in [subCount, 2 * subCount)
+        return static_cast<std::size_t>(subCount * (shift + 1) + ((m >> shift) - subCount));
+    }
+
+    Side negative, positive;
+    std::uint64_t total = 0;
+    double lo = 0.0, hi = 0.0;
+};
+
+// ============================================================================
+//  LinearHistogram - one bucket per non-negative integer (spins, streaks);
+//  exact quantiles, and the sum is an integer so the mean is exact too
+// ============================================================================
+class LinearHistogram { // Exact integer histogram
+public:
+    void add(int v) {
+        const std::size_t i = static_cast<std::size_t>(std::max(v, 0));
+        if (i >= counts.size()) counts.resize(i + 1);
+        ++counts[i]; ++total; sum += i;
+    }
+    void merge(const LinearHistogram& o) {
+        if (o.counts.size() > counts.size()) counts.resize(o.counts.size());
+        for (std::size_t i = 0; i < o.counts.size(); ++i) counts[i] += o.counts[i];
+        total += o.total; sum += o.sum;
+    }
+
+    std::uint64_t count() const { return total; }
+    double mean() const { return total ? static_cast<double>(sum) / static_cast<double>(total) : 0.0; }
+    int max() const { return counts.empty() ? 0 : static_cast<int>(counts.size() - 1); }
+    template<class Archive>
+    void transfer(Archive& ar) { ar(counts); ar(total); ar(sum); }
+    int quantile(double p) const {
+        if (total == 0) return 0;
+        const std::uint64_t rank = LogHistogram::rankOf(p, total);
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < counts.size(); ++i)
+            if ((seen += counts[i]) >= rank) return static_cast<int>(i);
+        return max();
+    }
+
+private:
+    std::vector<std::uint64_t> counts;    // trailing bucket is always non-empty
+    std::uint64_t total = 0, sum = 0;
+};
+
+// Wilson score interval for a binomial proportion
+inline void wilsonInterval(std::uint64_t hits, std::uint64_t n, double z, double& lo, double& hi) {
+    if (n == 0) { lo = 0.0; hi = 1.0; return; }
+    const double nn = static_cast<double>(n), p = static_cast<double>(hits) / nn, z2 = z * z;
+    const double centre = (p + z2 / (2 * nn)) / (1 + z2 / nn);
+    const double half = z * std::sqrt(p * (1 - p) / nn + z2 / (4 * nn * nn)) / (1 + z2 / nn);
+    lo = std::max(0.0, centre - half); hi = std::min(1.0, centre + half);
+}
+
+struct SessionSketch { // Per-session distributions of a batch
+    LogHistogram finalBankroll;
+    LinearHistogram longestLossStreak;    // longest run of losing spins, color switches included
+    LinearHistogram spinsToRuin;          // ruined sessions only
+
+    void add(const SessionResult& r) {
+        finalBankroll.add(r.finalBankroll);
+        longestLossStreak.add(r.longestLossStreak);
+        if (r.ruined) spinsToRuin.add(r.spins);
+    }
+    void merge(const SessionSketch& o) {
+        finalBankroll.merge(o.finalBankroll);
+        longestLossStreak.merge(o.longestLossStreak);
+        spinsToRuin.merge(o.spinsToRuin);
+    }
+};
@@ -0,0 +1,105 @@
+// ============================================================================
+//  StatsTracker.h - per-session spin statistics. Recording only bumps numeric
+//  counters and writes a raw record into a fixed ring buffer; text is built
+//  when print() is called. HistoryDepth = 0 removes the history at compile
+//  time, leaving the counters alone. A tracker can also forward every spin
+//  to a SpinTraceWriter for a full per-spin trace.
+//  Build:  C++20, Visual Studio 2022 (x64, Windows)
+// ============================================================================
+#pragma once
+
+#include "RouletteCore.h"
+#include "SpinTrace.h"
+#include "StrategyKernel.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+struct StatsRecord { // One history entry, formatted only when printed
+    enum class Kind : std::uint8_t { SPIN, WIN, LOSS };
+    Kind kind = Kind::SPIN;
+    RouletteOutcome outcome{};            // SPIN entries
+    double wager = 0.0;                   // WIN / LOSS entries
+};
+
+template<std::size_t HistoryDepth>
+class BasicStatsTracker { // Counters plus the last HistoryDepth records
+public:
+    static constexpr std::size_t historyDepth = HistoryDepth;
+
+    explicit BasicStatsTracker(int wheelZeros = AmericanLayout::zeros) : zeros(wheelZeros) {}
+
+    void recordWin(double b) { ++wins_; ++spins_; moneyBet_ += b; push({ StatsRecord::Kind::WIN, {}, b }); }
+    void recordLoss(double b) { ++losses_; ++spins_; moneyBet_ += b; push({ StatsRecord::Kind::LOSS, {}, b }); }
+    void addOutcomeToHistory(const RouletteOutcome& o) {
+        if (o.color == Color::GREEN) ++zeroHits[o.number ? o.number - 36 : 0]; // 0, 00, 000
+        push({ StatsRecord::Kind::SPIN, o, 0.0 });
+    }
+    // One settled spin: history, win/loss counters and, if attached, the trace; amounts are kept in dollars
+    template<class Money>
+    void recordSpin(std::uint8_t pocket, const BasicStepResult<Money>& step, const BasicSessionState<Money>& after) {
+        const double wager = Money::toDollars(step.wager);
+        addOutcomeToHistory(outcomeTable[pocket]);
+        if (step.won) recordWin(wager);
+        else recordLoss(wager);
+        if (trace) trace->append({ traceSession, after.spins, pocket, wager, Money::toDollars(step.net),
+            Money::toDollars(after.bankroll), Money::toDollars(after.currentBet), step.won, step.switchedColor, step.capHit });
+    }
+    void attachTrace(SpinTraceWriter* w, std::uint64_t session) { trace = w; traceSession = session; } // nullptr detaches
+
+    int wins() const { return wins_; }
+    int losses() const { return losses_; }
+    int spins() const { return spins_; }
+    double moneyBet() const { return moneyBet_; }
+    int greens() const { return zeroHits[0] + zeroHits[1] + zeroHits[2]; }
+    std::size_t historySize() const { return stored; }
+
+    void print(double bankroll, double currBet, int consLoss, Color betColor, std::ostream& os = std::cout) const { // Print stats
+        os << "\n===== Stats =====\n"
+            << "Bankroll: $" << bankroll << "\n"
+            << "Current Bet: $" << currBet << "\n"
+            << "Consecutive Losses: " << consLoss << "\n"
+            << "Betting on: " << colorToString(betColor) << "\n"
+            << "Spins: " << spins_ << " Wins: " << wins_ << " Losses: " << losses_ << " Total Bet: $" << moneyBet_ << "\n"
+            << "Recent (" << stored << "):\n";
+        if constexpr (HistoryDepth > 0) { // Oldest first
+            const std::size_t first = (head + HistoryDepth - stored) % HistoryDepth;
+            for (std::size_t i = 0; i < stored; ++i) os << "  " << format(history[(first + i) % HistoryDepth]) << "\n";
+        }
+        os << "Greens: " << greens() << " (";
+        for (int z = 0; z < zeros; ++z) os << (z ? ", " : "") << numberToString(z ? 36 + z : 0) << ": " << zeroHits[z];
+        os << ")\n=================\n";
+    }
+
+private:
+    static std::string format(const StatsRecord& r) { // Same text the tracker used to store per spin
+        switch (r.kind) {
+        case StatsRecord::Kind::WIN: return "Win:  $" + std::to_string(r.wager);
+        case StatsRecord::Kind::LOSS: return "Loss: $" + std::to_string(r.wager);
+        default: return "Spin: " + numberToString(r.outcome.number) + " (" + colorToString(r.outcome.color) + ", " + parityToString(r.outcome.parity) + ")";
+        }
+    }
+    void push(const StatsRecord& r) { // Overwrite the oldest record once full
+        if constexpr (HistoryDepth > 0) {
+            history[head] = r;
+            head = (head + 1) % HistoryDepth;
+            if (stored < HistoryDepth) ++stored;
+        }
+        else (void)r;
+    }
+
+    int wins_ = 0, losses_ = 0, spins_ = 0;
+    double moneyBet_ = 0;
+    int zeros;                            // green pockets on the wheel, for print()
+    int zeroHits[3] = {};                 // spins on 0, 00 and 000
+    std::array<StatsRecord, HistoryDepth> history{};
+    std::size_t head = 0, stored = 0;
+    SpinTraceWriter* trace = nullptr;
+    std::uint64_t traceSession = 0;
+};
+
+using StatsTracker = BasicStatsTracker<10>;     // interactive play: last 10 entries, as before
+using CounterStatsTracker = BasicStatsTracker<0>; // headless runs: counters only
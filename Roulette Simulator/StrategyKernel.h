@@ -0,0 +1,279 @@
+// ============================================================================
+//  StrategyKernel.h - the betting rules as plain data plus one pure step
+//  function. No I/O and no heap use; the interactive loop, the batch engine
+//  and the benchmarks all advance sessions through stepSession(). Amounts are
+//  a Money policy (Money.h): double dollars by default, or integer cents.
+//  Build:  C++20, Visual Studio 2022 (x64, Windows)
+// ============================================================================
+#pragma once
+
+#include "BetLayout.h"
+#include "Money.h"
+#include "RouletteCore.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// ============================================================================
+//  StrategyConfig - everything main() gathers from the user for one session
+// ============================================================================
+struct StrategyConfig {
+    double bankroll = 1000.0;             // starting bankroll
+    int lossThreshold = 3;                // consecutive losses before switching color
+    std::vector<double> lossMultipliers;  // empty = default 3 3 2
+    std::vector<double> winMultipliers;   // empty = reset to initial bet after a win
+    bool extraBet = false;                // $1 on each zero every spin
+    BetLayout sideBets;                   // further chips placed every spin, next to the color bet
+    double initialBet = 100.0;            // opening bet
+    double maxBet = 10000.0;              // maximum bet cap
+    WheelKind wheel = WheelKind::AMERICAN; // 0 and 00
+    std::string program;                  // strategy program source (StrategyProgram.h); empty = the multiplier rules above
+};
+
+// Engines that model the multiplier rules directly reject a configuration that carries a program
+inline void requireBuiltInRules(const StrategyConfig& cfg, const char* engine) {
+    if (!cfg.program.empty()) throw std::invalid_argument(std::string(engine) + " runs the built-in multiplier rules only, not strategy programs");
+}
+
+// Entry points (jobs, sweep grids) refuse an opening bet above the cap: the reset after a win is never capped
+inline void requireBetWithinCap(double initialBet, double maxBet) {
+    if (initialBet <= maxBet) return;
+    std::ostringstream os;
+    os << "The initial bet ($" << initialBet << ") is above the max bet ($" << maxBet << ")";
+    throw std::invalid_argument(os.str());
+}
+
+inline constexpr int maxStrategyMultipliers = 32; // longest multiplier list the kernel holds
+
+template<class Money>
+struct BasicMultiplierTable { // Fixed-capacity copy of a BettingStrategy
+    using Factor = typename Money::Factor;
+    std::array<Factor, maxStrategyMultipliers> values{};
+    int count = 0;
+    ROULETTE_HOST_DEVICE Factor get(int n) const { return values[(n <= count ? n : count) - 1]; } // same indexing as getMultiplier
+};
+
+template<class Money>
+struct BasicStrategyParams { // Immutable per session
+    using Amount = typename Money::Amount;
+    Amount startingBankroll{};
+    Amount initialBet{};
+    Amount maxBet{};
+    int lossThreshold = 0;
+    bool useWinMult = false;
+    bool pinsAtMaxBet = false;            // once the bet is maxBet, every outcome caps it there again
+    BasicPayoutTable<Money> side;         // extra bet and side bets: net result per pocket, in Money units
+    BasicMultiplierTable<Money> loss, win;
+};
+
+template<class Money>
+struct BasicSessionState { // Everything that changes spin to spin
+    using Amount = typename Money::Amount;
+    Amount bankroll{};
+    Amount currentBet{};
+    Amount nextProfitThresh{};
+    Color betColor = Color::BLACK;
+    int consecutiveLosses = 0, consecutiveWins = 0;
+    int maxBetHits = 0;
+    int spins = 0;
+    int lossStreak = 0, longestLossStreak = 0; // losing spins in a row; unlike consecutiveLosses, not reset by a color switch
+    int capRun = 0;                       // spins in a row whose next bet was capped at maxBet
+};
+
+template<class Money>
+struct BasicStepResult { // What one spin did, for the caller to report
+    typename Money::Amount wager{};       // main bet placed on this spin
+    typename Money::Amount net{};         // bankroll change including the side bets
+    bool won = false;
+    bool capHit = false;                  // next bet was clamped to maxBet
+    bool switchedColor = false;
+    bool profitThresholdReached = false;
+};
+
+using MultiplierTable = BasicMultiplierTable<DollarMoney>;
+using StrategyParams = BasicStrategyParams<DollarMoney>;
+using SessionState = BasicSessionState<DollarMoney>;
+using StepResult = BasicStepResult<DollarMoney>;
+
+template<class Money = DollarMoney>
+BasicMultiplierTable<Money> makeMultiplierTable(const BettingStrategy& s) { // Extra entries beyond capacity are dropped
+    BasicMultiplierTable<Money> t;
+    for (double m : s.values()) {
+        if (t.count == maxStrategyMultipliers) break;
+        t.values[t.count++] = Money::factor(m);
+    }
+    return t;
+}
+
+template<class Money = DollarMoney>
+BasicStrategyParams<Money> makeStrategyParams(const StrategyConfig& cfg) {
+    BasicStrategyParams<Money> p;
+    p.startingBankroll = Money::fromDollars(cfg.bankroll);
+    p.initialBet = Money::fromDollars(cfg.initialBet);
+    p.maxBet = Money::fromDollars(cfg.maxBet);
+    p.lossThreshold = cfg.lossThreshold;
+    p.useWinMult = !cfg.winMultipliers.empty();
+    p.side = compilePayouts<Money>(BetLayout(ExtraBetMode(cfg.extraBet, wheelZeros(cfg.wheel)).layout()).add(cfg.sideBets), cfg.wheel);
+    p.loss = makeMultiplierTable<Money>(BettingStrategy(cfg.lossMultipliers));
+    p.win = makeMultiplierTable<Money>(BettingStrategy(cfg.winMultipliers));
+    typename Money::Factor largest = p.loss.get(1);
+    for (int n = 1; n <= p.loss.count; ++n) largest = std::max(largest, p.loss.get(n));
+    for (int n = 1; n <= p.win.count; ++n) largest = std::max(largest, p.win.get(n));
+    Money::checkRange(std::max(p.maxBet, p.initialBet), largest);
+    // A loss at maxBet caps again if every reachable loss multiplier keeps it there (the count
+    // resets at the color switch); a win only caps with win multipliers that all reach maxBet
+    bool pinned = p.useWinMult && p.maxBet > 0;
+    for (int n = 1; pinned && n <= std::min(std::max(p.lossThreshold, 1), p.loss.count); ++n) pinned = Money::scale(p.maxBet, p.loss.get(n)) >= p.maxBet;
+    for (int n = 1; pinned && n <= p.win.count; ++n) pinned = Money::scale(p.initialBet, p.win.get(n)) >= p.maxBet;
+    p.pinsAtMaxBet = pinned;
+    return p;
+}
+
+template<class Money>
+ROULETTE_HOST_DEVICE BasicSessionState<Money> startSession(const BasicStrategyParams<Money>& p) {
+    BasicSessionState<Money> s;
+    s.bankroll = p.startingBankroll;
+    s.currentBet = p.initialBet;
+    s.nextProfitThresh = p.startingBankroll;
+    return s;
+}
+
+// A session continues while the bankroll covers the next bet and the 8-hour limit is not reached
+template<class Money>
+ROULETTE_HOST_DEVICE bool sessionActive(const BasicSessionState<Money>& s) {
+    return s.bankroll > 0 && s.spins * CasinoTimer::secondsPerSpin < CasinoTimer::sessionLimit && s.currentBet <= s.bankroll;
+}
+template<class Money>
+ROULETTE_HOST_DEVICE bool sessionRuined(const BasicSessionState<Money>& s) { return s.bankroll <= 0 || s.currentBet > s.bankroll; }
+
+struct SessionResult { // Outcome of one complete session
+    double finalBankroll = 0.0;
+    int spins = 0;
+    int maxBetHits = 0;
+    int longestLossStreak = 0;
+    bool ruined = false;                  // could no longer cover the next bet
+};
+
+template<class Money>
+SessionResult makeSessionResult(const BasicSessionState<Money>& s) {
+    SessionResult r;
+    r.finalBankroll = Money::toDollars(s.bankroll);
+    r.spins = s.spins;
+    r.maxBetHits = s.maxBetHits;
+    r.longestLossStreak = s.longestLossStreak;
+    r.ruined = sessionRuined(s);
+    return r;
+}
+
+// ----------------------------------------------------------------------------
+//  stepSession - settle one spin. `pocketClass` is pocketClassTable[pocket],
+//  passed in so bulk callers can classify a whole buffer up front.
+// ----------------------------------------------------------------------------
+template<class Money>
+ROULETTE_HOST_DEVICE BasicStepResult<Money> stepSession(BasicSessionState<Money>& s, const BasicStrategyParams<Money>& p, std::uint8_t pocket, std::uint8_t pocketClass) {
+    BasicStepResult<Money> r;
+    r.wager = s.currentBet;
+    const auto extraResult = p.side[pocket]; // every side chip at once
+
+    if (pocketClass & colorClassBit(s.betColor)) { // Win
+        r.won = true;
+        r.net = s.currentBet + extraResult;
+        s.bankroll += r.net;
+        ++s.consecutiveWins; s.consecutiveLosses = 0; s.lossStreak = 0;
+        if (p.useWinMult) { // Use win multipliers
+            auto newBet = Money::scale(p.initialBet, p.win.get(s.consecutiveWins));
+            if (newBet >= p.maxBet) { newBet = p.maxBet; r.capHit = true; } // Cap hit
+            s.currentBet = newBet;
+        }
+        else { // Reset to initial bet
+            s.currentBet = p.initialBet; s.consecutiveWins = 0;
+        }
+    }
+    else { // Lose
+        r.net = -s.currentBet + extraResult;
+        s.bankroll += r.net;
+        ++s.consecutiveLosses; s.consecutiveWins = 0;
+        if (++s.lossStreak > s.longestLossStreak) s.longestLossStreak = s.lossStreak;
+        auto newBet = Money::scale(s.currentBet, p.loss.get(s.consecutiveLosses));
+        if (newBet >= p.maxBet) { newBet = p.maxBet; r.capHit = true; } // Cap hit
+        s.currentBet = newBet;
+    }
+    if (s.consecutiveLosses >= p.lossThreshold) { // Switch color
+        s.betColor = (s.betColor == Color::BLACK) ? Color::RED : Color::BLACK;
+        s.consecutiveLosses = 0;
+        r.switchedColor = true;
+    }
+    if (r.capHit) ++s.maxBetHits;
+    s.capRun = r.capHit ? s.capRun + 1 : 0; // the interactive loop can pause on a long run
+    ++s.spins;
+    r.profitThresholdReached = s.bankroll - p.startingBankroll >= s.nextProfitThresh;
+    return r;
+}
+template<class Money>
+BasicStepResult<Money> stepSession(BasicSessionState<Money>& s, const BasicStrategyParams<Money>& p, std::uint8_t pocket) {
+    return stepSession(s, p, pocket, pocketClassTable[pocket]);
+}
+
+// What the interactive loop does when profitThresholdReached is set, instead of always asking
+enum class ProfitPolicy : std::uint8_t { ASK, CONTINUE, STOP };
+
+template<class Money>
+void acknowledgeProfitThreshold(BasicSessionState<Money>& s, const BasicStrategyParams<Money>& p) { // Player chose to keep going
+    s.nextProfitThresh += p.startingBankroll;
+}
+
+// ----------------------------------------------------------------------------
+//  Absorbing states. safeSpins() counts the spins a session is certain to
+//  play: losing every one of them still leaves the largest possible bet
+//  covered, and the time limit is further away. Inside that horizon nothing
+//  can end the session, so advanceSession() steps without the per-spin
+//  sessionActive() test. A session pinned at maxBet (pinnedAtMaxBet()) only
+//  drifts by +/- maxBet plus the side bets each spin, and takes a shorter
+//  step with no multiplier lookups. Both give exactly what stepSession()
+//  would, spin for spin, so results and streams are unchanged.
+// ----------------------------------------------------------------------------
+inline constexpr int sessionSpinLimit = (CasinoTimer::sessionLimit + CasinoTimer::secondsPerSpin - 1) / CasinoTimer::secondsPerSpin;
+
+template<class Money>
+int safeSpins(const BasicSessionState<Money>& s, const BasicStrategyParams<Money>& p) {
+    const auto largestBet = std::max(p.maxBet, p.initialBet), worstLoss = largestBet - p.side.worst;
+    if (s.bankroll < largestBet + worstLoss || worstLoss <= 0) return 0;
+    const double byBankroll = std::floor(static_cast<double>(s.bankroll - largestBet) / static_cast<double>(worstLoss)) - 1; // one spin of margin for rounding
+    return static_cast<int>(std::min<double>(byBankroll, sessionSpinLimit - s.spins));
+}
+template<class Money>
+bool pinnedAtMaxBet(const BasicSessionState<Money>& s, const BasicStrategyParams<Money>& p) { return p.pinsAtMaxBet && s.currentBet == p.maxBet; }
+
+// Play `n` spins, n <= safeSpins(s, p); per-spin results are not reported
+template<class Money>
+void advanceSession(BasicSessionState<Money>& s, const BasicStrategyParams<Money>& p, const std::uint8_t* pockets, const std::uint8_t* classes, int n) {
+    if (!pinnedAtMaxBet(s, p)) {
+        for (int i = 0; i < n; ++i) stepSession(s, p, pockets[i], classes[i]);
+        return;
+    }
+    for (int i = 0; i < n; ++i) { // stepSession() with currentBet fixed at maxBet and every spin a cap hit
+        const auto extraResult = p.side[pockets[i]];
+        if (classes[i] & colorClassBit(s.betColor)) {
+            s.bankroll += p.maxBet + extraResult;
+            ++s.consecutiveWins; s.consecutiveLosses = 0; s.lossStreak = 0;
+        }
+        else {
+            s.bankroll += -p.maxBet + extraResult;
+            ++s.consecutiveLosses; s.consecutiveWins = 0;
+            if (++s.lossStreak > s.longestLossStreak) s.longestLossStreak = s.lossStreak;
+        }
+        if (s.consecutiveLosses >= p.lossThreshold) {
+            s.betColor = (s.betColor == Color::BLACK) ? Color::RED : Color::BLACK;
+            s.consecutiveLosses = 0;
+        }
+    }
+    s.maxBetHits += n;
+    s.capRun += n;
+    s.spins += n;
+}
@@ -0,0 +1,610 @@
+// ============================================================================
+//  StrategyProgram.h - user-written betting strategies. A short text program
+//  says what to do after a win, after a loss and after every spin; it is
+//  compiled once into bytecode for a small stack machine, and the session
+//  loop runs that bytecode spin by spin with no parsing, no heap use and no
+//  virtual calls. Bankroll, streak counters, side bets, the maxBet cap and
+//  the end-of-session rules stay native, as in stepSession().
+//  Build:  C++20, Visual Studio 2022 (x64, Windows)
+// ============================================================================
+#pragma once
+
+#include "BetLayout.h"
+#include "RouletteCore.h"
+#include "SpinBatch.h"
+#include "StrategyKernel.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+//  The language
+//
+//    setup:  statements run once when a session opens
+//    win:    statements run after a winning spin
+//    loss:   statements run after a losing spin
+//    always: statements run after every spin, after win / loss
+//
+//  Statements are separated by ';' or new lines, and any statement can take a
+//  trailing "if <condition>". '#' starts a comment.
+//
+//    x = expr               assign bet, wins, losses or a variable of your own
+//    switch                 bet the other color; also clears losses
+//    stop                   end the session (stop-loss, take-profit)
+//    push expr              append to the list; at most one push may run per
+//                           spin, counting win / loss and always together
+//    drop_first, drop_last  remove from either end of the list
+//    reset                  restore the list from setup
+//    list 1 2 3 4           setup only: the starting list
+//    table name = 3 3 2     setup only: name[n] is the n-th entry (1-based,
+//                           the last one past the end), like BettingStrategy
+//
+//  Expressions use numbers, + - * /, comparisons, and / or / not, parentheses,
+//  min(a, b), max(a, b), abs(x), floor(x), fib(n) and if(c, a, b). Readable
+//  values: bet, base (initial bet), max (bet cap), bankroll, start (starting
+//  bankroll), profit, wins, losses, spins, won (1 after a win), first, last
+//  and count (the list). Bets are capped at max after every spin and counted
+//  as cap hits; a session also ends when the bet is not positive.
+// ----------------------------------------------------------------------------
+namespace strategy_vm {
+
+enum class Op : std::uint8_t {
+    CONST, LOAD, STORE,
+    ADD, SUB, MUL, DIV, NEG, MIN, MAX, ABS, FLOOR, FIB, SELECT,
+    LT, LE, GT, GE, EQ, NE, AND, OR, NOT,
+    TABLE, FIRST, LAST, COUNT,
+    PUSH, DROP_FIRST, DROP_LAST, RESET, SWITCH, STOP,
+    JUMP_IF_NOT, END,
+};
+
+struct Instruction { // 4 bytes; arg is a constant, variable, table or jump target
+    Op op;
+    std::uint8_t unused = 0;
+    std::uint16_t arg = 0;
+};
+
+// Variable slots; the first ones are the session's own state
+enum Slot : std::uint16_t { BET, BASE, MAX, BANKROLL, START, PROFIT, WINS, LOSSES, SPINS, WON, firstUserSlot };
+inline constexpr int maxSlots = 32;
+inline constexpr int maxStack = 32;
+inline constexpr int maxListStart = 64;   // entries a setup list may hold
+inline constexpr int listCapacity = maxListStart + sessionSpinLimit; // the compiler allows one push per spin, and setup pushes within maxListStart
+
+} // namespace strategy_vm
+
+// Everything a running program changes; fixed size, so sessions never allocate
+struct ProgramState {
+    double slot[strategy_vm::maxSlots] = {};
+    double list[strategy_vm::listCapacity];
+    int head = 0, tail = 0;               // list is [head, tail)
+    Color betColor = Color::BLACK;
+    int lossStreak = 0, longestLossStreak = 0, maxBetHits = 0;
+    bool stopped = false;
+};
+
+// ============================================================================
+//  StrategyProgram
+//  compile() throws std::invalid_argument naming the line of the first error.
+// ============================================================================
+class StrategyProgram { // Compiled strategy
+public:
+    static StrategyProgram compile(const std::string& source);
+
+    // Play one session on `wheel` in the same 64-spin blocks as SimulationEngine::playSession()
+    template<class Wheel>
+    SessionResult playSession(Wheel& wheel, const StrategyParams& rules) const {
+        ProgramState s;
+        start(s, rules);
+        std::uint8_t pockets[spinBlock], classes[spinBlock];
+        std::size_t next = spinBlock;
+        while (active(s)) {
+            if (next == spinBlock) { wheel.spinBatch(pockets); classifyPockets(pockets, classes); next = 0; }
+            step(s, rules, pockets[next], classes[next]);
+            ++next;
+        }
+        SessionResult r;
+        r.finalBankroll = s.slot[strategy_vm::BANKROLL];
+        r.spins = static_cast<int>(s.slot[strategy_vm::SPINS]);
+        r.maxBetHits = s.maxBetHits;
+        r.longestLossStreak = s.longestLossStreak;
+        r.ruined = ruined(s);
+        return r;
+    }
+
+    void start(ProgramState& s, const StrategyParams& rules) const {
+        using namespace strategy_vm;
+        std::fill(std::begin(s.slot), std::end(s.slot), 0.0); // user variables start at zero
+        s.betColor = Color::BLACK;
+        s.lossStreak = s.longestLossStreak = s.maxBetHits = 0;
+        s.stopped = false;
+        s.slot[BET] = rules.initialBet; s.slot[BASE] = rules.initialBet; s.slot[MAX] = rules.maxBet;
+        s.slot[BANKROLL] = rules.startingBankroll; s.slot[START] = rules.startingBankroll;
+        resetList(s);
+        execute(setupEntry, s);
+    }
+    bool active(const ProgramState& s) const {
+        using namespace strategy_vm;
+        const double bank = s.slot[BANKROLL], bet = s.slot[BET];
+        return !s.stopped && bank > 0 && s.slot[SPINS] < sessionSpinLimit && bet > 0 && bet <= bank;
+    }
+    static bool ruined(const ProgramState& s) {
+        return s.slot[strategy_vm::BANKROLL] <= 0 || s.slot[strategy_vm::BET] > s.slot[strategy_vm::BANKROLL];
+    }
+
+    // One spin: settle natively, then run the win or loss handler and the always handler
+    void step(ProgramState& s, const StrategyParams& rules, std::uint8_t pocket, std::uint8_t pocketClass) const {
+        using namespace strategy_vm;
+        const bool won = (pocketClass & colorClassBit(s.betColor)) != 0;
+        const double bet = s.slot[BET];
+        s.slot[BANKROLL] += (won ? bet : -bet) + rules.side[pocket];
+        s.slot[PROFIT] = s.slot[BANKROLL] - s.slot[START];
+        s.slot[SPINS] += 1;
+        s.slot[WON] = won ? 1 : 0;
+        if (won) { s.slot[WINS] += 1; s.slot[LOSSES] = 0; s.lossStreak = 0; }
+        else {
+            s.slot[LOSSES] += 1; s.slot[WINS] = 0;
+            if (++s.lossStreak > s.longestLossStreak) s.longestLossStreak = s.lossStreak;
+        }
+        execute(won ? winEntry : lossEntry, s);
+        execute(alwaysEntry, s);
+        if (s.slot[BET] >= s.slot[MAX]) { s.slot[BET] = s.slot[MAX]; ++s.maxBetHits; }
+    }
+
+    std::size_t size() const { return code.size(); } // instructions, all handlers
+
+private:
+    static constexpr std::size_t spinBlock = 64;
+
+    void resetList(ProgramState& s) const {
+        s.head = 0; s.tail = static_cast<int>(listStart.size());
+        std::copy(listStart.begin(), listStart.end(), s.list);
+    }
+
+    // The interpreter. Handlers are straight-line code with forward jumps only, so
+    // the loop always reaches END; the compiler has checked the stack depth.
+    void execute(std::uint16_t pc, ProgramState& s) const {
+        using namespace strategy_vm;
+        double stack[maxStack];
+        int sp = 0;
+        for (;;) {
+            const Instruction in = code[pc++];
+            switch (in.op) {
+            case Op::CONST: stack[sp++] = constants[in.arg]; break;
+            case Op::LOAD: stack[sp++] = s.slot[in.arg]; break;
+            case Op::STORE: s.slot[in.arg] = stack[--sp]; break;
+            case Op::ADD: --sp; stack[sp - 1] += stack[sp]; break;
+            case Op::SUB: --sp; stack[sp - 1] -= stack[sp]; break;
+            case Op::MUL: --sp; stack[sp - 1] *= stack[sp]; break;
+            case Op::DIV: --sp; stack[sp - 1] /= stack[sp]; break;
+            case Op::NEG: stack[sp - 1] = -stack[sp - 1]; break;
+            case Op::MIN: --sp; stack[sp - 1] = std::min(stack[sp - 1], stack[sp]); break;
+            case Op::MAX: --sp; stack[sp - 1] = std::max(stack[sp - 1], stack[sp]); break;
+            case Op::ABS: stack[sp - 1] = std::fabs(stack[sp - 1]); break;
+            case Op::FLOOR: stack[sp - 1] = std::floor(stack[sp - 1]); break;
+            case Op::FIB: stack[sp - 1] = fibonacci(stack[sp - 1]); break;
+            case Op::SELECT: sp -= 2; stack[sp - 1] = stack[sp - 1] != 0 ? stack[sp] : stack[sp + 1]; break;
+            case Op::LT: --sp; stack[sp - 1] = stack[sp - 1] < stack[sp]; break;
+            case Op::LE: --sp; stack[sp - 1] = stack[sp - 1] <= stack[sp]; break;
+            case Op::GT: --sp; stack[sp - 1] = stack[sp - 1] > stack[sp]; break;
+            case Op::GE: --sp; stack[sp - 1] = stack[sp - 1] >= stack[sp]; break;
+            case Op::EQ: --sp; stack[sp - 1] = stack[sp - 1] == stack[sp]; break;
+            case Op::NE: --sp; stack[sp - 1] = stack[sp - 1] != stack[sp]; break;
+            case Op::AND: --sp; stack[sp - 1] = stack[sp - 1] != 0 && stack[sp] != 0; break;
+            case Op::OR: --sp; stack[sp - 1] = stack[sp - 1] != 0 || stack[sp] != 0; break;
+            case Op::NOT: stack[sp - 1] = stack[sp - 1] == 0; break;
+            case Op::TABLE: { // 1-based, clamped to the last entry, as BettingStrategy::getMultiplier
+                const Table& t = tables[in.arg];
+                const double n = stack[sp - 1];
+                const int k = n >= t.count ? t.count : n >= 1 ? static_cast<int>(n) : 1;
+                stack[sp - 1] = constants[t.first + k - 1];
+                break;
+            }
+            case Op::FIRST: stack[sp++] = s.head < s.tail ? s.list[s.head] : 0.0; break;
+            case Op::LAST: stack[sp++] = s.head < s.tail ? s.list[s.tail - 1] : 0.0; break;
+            case Op::COUNT: stack[sp++] = s.tail - s.head; break;
+            case Op::PUSH: s.list[s.tail++] = stack[--sp]; break; // room checked by the compiler
+            case Op::DROP_FIRST: if (s.head < s.tail) ++s.head; break;
+            case Op::DROP_LAST: if (s.head < s.tail) --s.tail; break;
+            case Op::RESET: resetList(s); break;
+            case Op::SWITCH: s.betColor = s.betColor == Color::BLACK ? Color::RED : Color::BLACK; s.slot[LOSSES] = 0; break;
+            case Op::STOP: s.stopped = true; break;
+            case Op::JUMP_IF_NOT: if (stack[--sp] == 0) pc = in.arg; break;
+            case Op::END: return;
+            }
+        }
+    }
+    static double fibonacci(double n) { // fib(1) = fib(2) = 1; below 1 is 1
+        double a = 1, b = 1;
+        for (int k = 2; k < n && k < 1476; ++k) { const double c = a + b; a = b; b = c; } // fib(1476) overflows a double
+        return b;
+    }
+
+    struct Table { std::uint16_t first = 0, count = 0; }; // entries are constants[first, first + count)
+
+    class Compiler;
+
+    using Instruction = strategy_vm::Instruction;
+    std::vector<Instruction> code;
+    std::vector<double> constants;
+    std::vector<Table> tables;
+    std::vector<double> listStart;
+    std::uint16_t setupEntry = 0, winEntry = 0, lossEntry = 0, alwaysEntry = 0;
+};
+
+// ----------------------------------------------------------------------------
+//  StrategyProgram::Compiler - recursive descent straight to bytecode, one
+//  line at a time. Constant subexpressions are folded, so "bet * (1 + 1)"
+//  compiles to one MUL.
+// ----------------------------------------------------------------------------
+class StrategyProgram::Compiler {
+public:
+    explicit Compiler(const std::string& src) : source(src) {}
+
+    StrategyProgram run() {
+        using namespace strategy_vm;
+        std::vector<std::vector<Instruction>> handlers(4); // setup, win, loss, always
+        int section = -1;
+        std::istringstream lines(source);
+        std::string line;
+        for (lineNo = 1; std::getline(lines, line); ++lineNo) {
+            line = line.substr(0, line.find('#'));
+            tokenize(line);
+            if (atEnd()) continue;
+            static const char* const headers[] = { "setup", "win", "loss", "always" };
+            for (int h = 0; h < 4; ++h)
+                if (peek() == headers[h] && peek(1) == ":") { section = h; pos += 2; }
+            if (atEnd()) continue;
+            if (section < 0) fail("statement before setup:, win:, loss: or always:");
+            out = &handlers[section];
+            statements(section == 0);
+        }
+        if (section < 0) fail("empty program");
+        checkPushes(handlers);
+        for (auto& h : handlers) { // one code array; jump targets become absolute
+            const std::size_t base = program.code.size();
+            entries.push_back(static_cast<std::uint16_t>(base));
+            for (Instruction in : h) {
+                if (in.op == Op::JUMP_IF_NOT) in.arg = static_cast<std::uint16_t>(in.arg + base);
+                program.code.push_back(in);
+            }
+            program.code.push_back({ Op::END });
+        }
+        if (program.code.size() > 0xFFFF || program.constants.size() > 0xFFFF) fail("program too long");
+        program.setupEntry = entries[0]; program.winEntry = entries[1];
+        program.lossEntry = entries[2]; program.alwaysEntry = entries[3];
+        return program;
+    }
+
+private:
+    struct Value { bool constant = false; double number = 0; int depth = 0; }; // compile-time view of an expression
+
+    // --- tokens ---
+    void tokenize(const std::string& line) {
+        tokens.clear(); pos = 0;
+        for (std::size_t i = 0; i < line.size(); ) {
+            const char c = line[i];
+            if (std::isspace(static_cast<unsigned char>(c))) { ++i; continue; }
+            std::size_t j = i + 1;
+            if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') { // exponents too, as in 1e-05
+                while (j < line.size() && (std::isalnum(static_cast<unsigned char>(line[j])) || line[j] == '.'
+                    || ((line[j] == '-' || line[j] == '+') && (line[j - 1] == 'e' || line[j - 1] == 'E')))) ++j;
+            }
+            else if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+                while (j < line.size() && (std::isalnum(static_cast<unsigned char>(line[j])) || line[j] == '_')) ++j;
+            }
+            else if ((c == '<' || c == '>' || c == '=' || c == '!') && j < line.size() && line[j] == '=') ++j;
+            tokens.push_back(line.substr(i, j - i));
+            i = j;
+        }
+    }
+    bool atEnd() const { return pos >= tokens.size(); }
+    const std::string& peek(std::size_t ahead = 0) const { static const std::string none; return pos + ahead < tokens.size() ? tokens[pos + ahead] : none; }
+    bool accept(const char* t) { if (peek() == t) { ++pos; return true; } return false; }
+    void expect(const char* t) { if (!accept(t)) fail(std::string("expected '") + t + "'"); }
+    [[noreturn]] void fail(const std::string& what) const {
+        throw std::invalid_argument("Strategy program" + (lineNo ? ", line " + std::to_string(lineNo) : std::string()) + ": " + what); // 0: the whole program
+    }
+    static bool isNumber(const std::string& t) { return !t.empty() && (std::isdigit(static_cast<unsigned char>(t[0])) || t[0] == '.'); }
+    double number(const std::string& t) const {
+        std::size_t used = 0;
+        double v = 0;
+        try { v = std::stod(t, &used); }
+        catch (const std::exception&) { used = 0; }
+        if (used != t.size()) fail("bad number '" + t + "'");
+        return v;
+    }
+    double literal() { const bool negative = accept("-"); const double v = number(atEnd() ? "" : tokens[pos++]); return negative ? -v : v; }
+    static bool isIdentifier(const std::string& t) { return !t.empty() && (std::isalpha(static_cast<unsigned char>(t[0])) || t[0] == '_'); }
+
+    // --- emitting ---
+    void emit(strategy_vm::Op op, std::uint16_t arg = 0) { out->push_back({ op, 0, arg }); }
+    std::uint16_t constant(double v) {
+        for (std::size_t k = 0; k < program.constants.size(); ++k)
+            if (program.constants[k] == v && !std::signbit(program.constants[k]) == !std::signbit(v)) return static_cast<std::uint16_t>(k);
+        program.constants.push_back(v);
+        return static_cast<std::uint16_t>(program.constants.size() - 1);
+    }
+    void materialize(Value& v) { // a folded constant becomes a CONST once something needs it on the stack
+        if (v.constant) { emit(strategy_vm::Op::CONST, constant(v.number)); v.constant = false; v.depth = 1; }
+    }
+    Value binary(Value a, std::size_t aEnd, Value b, strategy_vm::Op op) {
+        using strategy_vm::Op;
+        if (a.constant && b.constant) { // fold; the operands emitted nothing
+            Value r; r.constant = true; r.number = apply(op, a.number, b.number);
+            return r;
+        }
+        if (a.constant) { // a's CONST must come before b's code
+            out->insert(out->begin() + static_cast<std::ptrdiff_t>(aEnd), { Op::CONST, 0, constant(a.number) });
+            a.constant = false; a.depth = 1;
+        }
+        materialize(b);
+        emit(op);
+        Value r; r.depth = std::max(a.depth, 1 + b.depth);
+        if (r.depth > strategy_vm::maxStack) fail("expression too deep");
+        return r;
+    }
+    static double apply(strategy_vm::Op op, double a, double b) {
+        using strategy_vm::Op;
+        switch (op) {
+        case Op::ADD: return a + b; case Op::SUB: return a - b; case Op::MUL: return a * b; case Op::DIV: return a / b;
+        case Op::MIN: return std::min(a, b); case Op::MAX: return std::max(a, b);
+        case Op::LT: return a < b; case Op::LE: return a <= b; case Op::GT: return a > b; case Op::GE: return a >= b;
+        case Op::EQ: return a == b; case Op::NE: return a != b;
+        case Op::AND: return a != 0 && b != 0; case Op::OR: return a != 0 || b != 0;
+        default: return 0;
+        }
+    }
+    Value unary(Value a, strategy_vm::Op op) {
+        using strategy_vm::Op;
+        if (a.constant) {
+            switch (op) {
+            case Op::NEG: a.number = -a.number; return a;
+            case Op::NOT: a.number = a.number == 0; return a;
+            case Op::ABS: a.number = std::fabs(a.number); return a;
+            case Op::FLOOR: a.number = std::floor(a.number); return a;
+            case Op::FIB: a.number = fibonacci(a.number); return a;
+            default: break;
+            }
+        }
+        materialize(a);
+        emit(op);
+        return a;
+    }
+
+    // --- statements ---
+    void statements(bool setup) {
+        for (;;) {
+            statement(setup);
+            if (atEnd()) return;
+            expect(";");
+            if (atEnd()) return;
+        }
+    }
+    void statement(bool setup) {
+        using namespace strategy_vm;
+        if (setup && accept("list")) { // declarations: compile time only
+            program.listStart.clear();
+            while (!atEnd() && peek() != ";") program.listStart.push_back(literal());
+            if (program.listStart.size() > maxListStart) fail("list longer than " + std::to_string(maxListStart));
+            return;
+        }
+        if (setup && accept("table")) {
+            const std::string name = tokens.size() > pos ? tokens[pos++] : "";
+            if (!isIdentifier(name) || slotOf(name) >= 0 || tableOf(name) >= 0) fail("bad or duplicate table name '" + name + "'");
+            expect("=");
+            Table t; t.first = static_cast<std::uint16_t>(program.constants.size());
+            while (!atEnd() && peek() != ";") { program.constants.push_back(literal()); ++t.count; }
+            if (t.count == 0) fail("table '" + name + "' has no entries");
+            tableNames.push_back(name); program.tables.push_back(t);
+            return;
+        }
+        // The body is compiled first; a trailing guard is compiled after it and then moved in front
+        const std::size_t bodyStart = out->size();
+        simpleStatement();
+        if (!accept("if")) return;
+        std::vector<Instruction> body(out->begin() + static_cast<std::ptrdiff_t>(bodyStart), out->end());
+        out->resize(bodyStart);
+        Value c = expression();
+        materialize(c);
+        emit(Op::JUMP_IF_NOT, static_cast<std::uint16_t>(out->size() + 1 + body.size()));
+        const std::size_t newBodyStart = out->size();
+        for (Instruction in : body) { // relocate jumps inside the body
+            if (in.op == Op::JUMP_IF_NOT) in.arg = static_cast<std::uint16_t>(in.arg - bodyStart + newBodyStart);
+            out->push_back(in);
+        }
+    }
+    void simpleStatement() {
+        using namespace strategy_vm;
+        const std::string word = atEnd() ? "" : tokens[pos++];
+        if (word == "switch") { emit(Op::SWITCH); return; }
+        if (word == "stop") { emit(Op::STOP); return; }
+        if (word == "drop_first") { emit(Op::DROP_FIRST); return; }
+        if (word == "drop_last") { emit(Op::DROP_LAST); return; }
+        if (word == "reset") { emit(Op::RESET); return; }
+        if (word == "push") { Value v = expression(); materialize(v); emit(Op::PUSH); return; }
+        if (!isIdentifier(word) || !accept("=")) fail("expected a statement, found '" + word + "'");
+        int slot = slotOf(word);
+        if (slot < 0) {
+            if (isReserved(word) || tableOf(word) >= 0) fail("'" + word + "' cannot be assigned");
+            if (names.size() + firstUserSlot >= maxSlots) fail("too many variables");
+            names.push_back(word);
+            slot = static_cast<int>(names.size()) + firstUserSlot - 1;
+        }
+        else if (slot != BET && slot != WINS && slot != LOSSES && slot < firstUserSlot) fail("'" + word + "' is read-only");
+        Value v = expression();
+        materialize(v);
+        emit(Op::STORE, static_cast<std::uint16_t>(slot));
+    }
+
+    // --- expressions, lowest precedence first ---
+    Value expression() { return orExpr(); }
+    Value orExpr() {
+        Value a = andExpr();
+        while (true) { const std::size_t end = out->size(); if (!accept("or")) return a; a = binary(a, end, andExpr(), strategy_vm::Op::OR); }
+    }
+    Value andExpr() {
+        Value a = notExpr();
+        while (true) { const std::size_t end = out->size(); if (!accept("and")) return a; a = binary(a, end, notExpr(), strategy_vm::Op::AND); }
+    }
+    Value notExpr() {
+        if (accept("not")) return unary(notExpr(), strategy_vm::Op::NOT);
+        return comparison();
+    }
+    Value comparison() {
+        using strategy_vm::Op;
+        Value a = sum();
+        static const std::pair<const char*, Op> ops[] = { { "<", Op::LT }, { "<=", Op::LE }, { ">", Op::GT }, { ">=", Op::GE }, { "==", Op::EQ }, { "!=", Op::NE } };
+        const std::size_t end = out->size();
+        for (const auto& [t, op] : ops) if (accept(t)) return binary(a, end, sum(), op);
+        return a;
+    }
+    Value sum() {
+        Value a = term();
+        while (true) {
+            const std::size_t end = out->size();
+            if (accept("+")) a = binary(a, end, term(), strategy_vm::Op::ADD);
+            else if (accept("-")) a = binary(a, end, term(), strategy_vm::Op::SUB);
+            else return a;
+        }
+    }
+    Value term() {
+        Value a = factor();
+        while (true) {
+            const std::size_t end = out->size();
+            if (accept("*")) a = binary(a, end, factor(), strategy_vm::Op::MUL);
+            else if (accept("/")) a = binary(a, end, factor(), strategy_vm::Op::DIV);
+            else return a;
+        }
+    }
+    Value factor() {
+        using namespace strategy_vm;
+        if (accept("-")) return unary(factor(), Op::NEG);
+        if (accept("(")) { Value v = expression(); expect(")"); return v; }
+        const std::string t = atEnd() ? "" : tokens[pos++];
+        if (isNumber(t)) { Value v; v.constant = true; v.number = number(t); return v; }
+        if (!isIdentifier(t)) fail("expected a value, found '" + t + "'");
+        if (accept("(")) return call(t);
+        if (const int table = tableOf(t); table >= 0) {
+            expect("[");
+            Value index = expression();
+            expect("]");
+            materialize(index);
+            emit(Op::TABLE, static_cast<std::uint16_t>(table));
+            return index;
+        }
+        Value v; v.depth = 1;
+        if (t == "first") emit(Op::FIRST);
+        else if (t == "last") emit(Op::LAST);
+        else if (t == "count") emit(Op::COUNT);
+        else if (const int slot = slotOf(t); slot >= 0) emit(Op::LOAD, static_cast<std::uint16_t>(slot));
+        else fail("unknown name '" + t + "'");
+        return v;
+    }
+    Value call(const std::string& f) {
+        using strategy_vm::Op;
+        auto one = [&](Op op) { Value a = expression(); expect(")"); return unary(a, op); };
+        if (f == "abs") return one(Op::ABS);
+        if (f == "floor") return one(Op::FLOOR);
+        if (f == "fib") return one(Op::FIB);
+        if (f == "min" || f == "max") {
+            Value a = expression();
+            const std::size_t end = out->size();
+            expect(",");
+            Value b = expression();
+            expect(")");
+            return binary(a, end, b, f == "min" ? Op::MIN : Op::MAX);
+        }
+        if (f == "if") { // all three operands are evaluated; SELECT picks one
+            Value c = expression(); materialize(c); expect(",");
+            Value a = expression(); materialize(a); expect(",");
+            Value b = expression(); materialize(b); expect(")");
+            emit(Op::SELECT);
+            Value r; r.depth = std::max({ c.depth, 1 + a.depth, 2 + b.depth });
+            if (r.depth > strategy_vm::maxStack) fail("expression too deep");
+            return r;
+        }
+        fail("unknown function '" + f + "'");
+    }
+
+    // The list has room for its setup entries plus one push per spin. A guarded push counts
+    // as one, so a program that could ever push past that is rejected here, not truncated.
+    void checkPushes(const std::vector<std::vector<Instruction>>& handlers) {
+        auto pushes = [&](int h) { return std::count_if(handlers[h].begin(), handlers[h].end(), [](const Instruction& in) { return in.op == strategy_vm::Op::PUSH; }); };
+        lineNo = 0;
+        if (static_cast<std::ptrdiff_t>(program.listStart.size()) + pushes(0) > strategy_vm::maxListStart)
+            fail("setup pushes past the list's " + std::to_string(strategy_vm::maxListStart) + " starting entries");
+        if (std::max(pushes(1), pushes(2)) + pushes(3) > 1)
+            fail("more than one push can run in a spin (win or loss, then always); the list holds one per spin");
+    }
+
+    // --- names ---
+    int slotOf(const std::string& n) const {
+        static const char* const builtins[] = { "bet", "base", "max", "bankroll", "start", "profit", "wins", "losses", "spins", "won" };
+        for (int k = 0; k < strategy_vm::firstUserSlot; ++k) if (n == builtins[k]) return k;
+        for (std::size_t k = 0; k < names.size(); ++k) if (n == names[k]) return static_cast<int>(k) + strategy_vm::firstUserSlot;
+        return -1;
+    }
+    int tableOf(const std::string& n) const {
+        for (std::size_t k = 0; k < tableNames.size(); ++k) if (n == tableNames[k]) return static_cast<int>(k);
+        return -1;
+    }
+    static bool isReserved(const std::string& n) {
+        static const char* const words[] = { "first", "last", "count", "if", "and", "or", "not", "switch", "stop", "push",
+            "drop_first", "drop_last", "reset", "list", "table", "min", "max", "abs", "floor", "fib", "setup", "win", "loss", "always" };
+        return std::any_of(std::begin(words), std::end(words), [&](const char* w) { return n == w; });
+    }
+
+    const std::string& source;
+    std::vector<std::string> tokens;
+    std::size_t pos = 0;
+    int lineNo = 0;
+    StrategyProgram program;
+    std::vector<Instruction>* out = nullptr;
+    std::vector<std::string> names, tableNames;
+    std::vector<std::uint16_t> entries;
+};
+
+inline StrategyProgram StrategyProgram::compile(const std::string& source) { return Compiler(source).run(); }
+
+// ----------------------------------------------------------------------------
+//  Presets. multiplierStrategySource() writes the built-in rules of a
+//  configuration as a program; it plays every session exactly as the kernel
+//  does whenever initialBet is below maxBet.
+// ----------------------------------------------------------------------------
+inline std::string multiplierStrategySource(const StrategyConfig& cfg) {
+    std::ostringstream s;
+    s << std::setprecision(17);
+    const BettingStrategy loss(cfg.lossMultipliers);
+    s << "setup: table lossmult =";
+    for (double m : loss.values()) s << ' ' << m;
+    if (!cfg.winMultipliers.empty()) {
+        s << "; table winmult =";
+        for (double m : cfg.winMultipliers) s << ' ' << m;
+        s << "\nwin: bet = base * winmult[wins]\n";
+    }
+    else s << "\nwin: bet = base; wins = 0\n";
+    s << "loss: bet = bet * lossmult[losses]\n"
+        << "always: switch if losses >= " << cfg.lossThreshold << "\n";
+    return s.str();
+}
+
+inline std::string presetStrategySource(const std::string& name) { // "" if there is no such preset
+    if (name == "martingale") return "win: bet = base\nloss: bet = bet * 2\n";
+    if (name == "fibonacci") return "setup: n = 1\nwin: n = max(1, n - 2)\nloss: n = n + 1\nalways: bet = base * fib(n)\n";
+    if (name == "dalembert") return "win: bet = max(base, bet - base)\nloss: bet = bet + base\n";
+    if (name == "labouchere") // bet the ends of the list, in units of the initial bet; start over once it is crossed out
+        return "setup: list 1 2 3 4; bet = base * (first + last)\n"
+            "win: drop_first; drop_last; reset if count == 0\n"
+            "loss: push bet / base\n"
+            "always: bet = base * if(count > 1, first + last, first)\n";
+    return "";
+}
@@ -0,0 +1,224 @@
+// ============================================================================
+//  SweepRunner.h - parameter sweeps over the cross product of strategy
+//  settings. Configurations are sampled in rounds of growing size; after each
+//  round a configuration whose ruin probability is confidently worse than the
+//  current best (Wilson score intervals) stops receiving sessions. Survivors
+//  share one pocket stream per session (CommonRandomEngine).
+//  Build:  C++20, Visual Studio 2022 (x64, Windows)
+// ============================================================================
+#pragma once
+
+#include "CommonRandomEngine.h"
+#include "SimulationEngine.h"
+#include "StrategyKernel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct SweepGrid { // Every combination of these values is one configuration
+    double bankroll = 1000.0;
+    bool extraBet = false;
+    WheelKind wheel = WheelKind::AMERICAN;
+    BetLayout sideBets;                   // same side bets in every configuration
+    std::vector<int> lossThresholds{ 3 };
+    std::vector<std::vector<double>> lossMultiplierSets{ {} };   // {} = default 3 3 2
+    std::vector<std::vector<double>> winMultiplierSets{ {} };    // {} = reset after a win
+    std::vector<double> initialBets{ 100.0 };
+    std::vector<double> maxBets{ 10000.0 };
+
+    std::vector<StrategyConfig> expand() const { // Cross product, maxBets varying fastest
+        std::vector<StrategyConfig> out;
+        out.reserve(lossThresholds.size() * lossMultiplierSets.size() * winMultiplierSets.size() * initialBets.size() * maxBets.size());
+        for (int t : lossThresholds)
+            for (const auto& lm : lossMultiplierSets)
+                for (const auto& wm : winMultiplierSets)
+                    for (double ib : initialBets)
+                        for (double mb : maxBets) {
+                            StrategyConfig c;
+                            c.bankroll = bankroll; c.extraBet = extraBet; c.wheel = wheel; c.sideBets = sideBets;
+                            c.lossThreshold = t; c.lossMultipliers = lm; c.winMultipliers = wm;
+                            c.initialBet = ib; c.maxBet = mb;
+                            out.push_back(std::move(c));
+                        }
+        return out;
+    }
+    void requireBetsWithinCaps() const { // every combination opens at or below its cap; throws std::invalid_argument
+        if (!initialBets.empty() && !maxBets.empty())
+            requireBetWithinCap(*std::max_element(initialBets.begin(), initialBets.end()), *std::min_element(maxBets.begin(), maxBets.end()));
+    }
+};
+
+struct SweepCheckpointHook;
+
+struct SweepOptions { // Sampling budget and pruning
+    std::uint64_t maxSessions = 100000;   // per configuration, if it is never pruned
+    std::uint64_t firstRound = 1024;      // sessions per configuration in round one; doubles each round
+    double z = 3.0;                       // Wilson interval width, in standard deviations
+    bool halving = false;                 // also drop the worse half of the survivors every round
+    std::uint64_t masterSeed = 0;         // every configuration plays the same session streams
+    GeneratorKind generator = GeneratorKind::XOSHIRO256X8; // behind those streams
+    unsigned threads = 0;                 // 0 = one per hardware thread
+    Telemetry* telemetry = nullptr;       // live progress, in configuration-sessions
+    SweepCheckpointHook* checkpoint = nullptr; // a save after every round, and a round to resume from (Checkpoint.h)
+};
+
+struct SweepEntry { // One configuration's standing
+    StrategyConfig config;
+    std::uint64_t sessions = 0, ruined = 0;
+    double finalSum = 0.0;                // sum of final bankrolls over the sessions played
+    int prunedInRound = 0;                // 0 = survived to the end
+    BatchResult detail;                   // distributed sweeps: every shard merged, sketch included
+    double ruinProbability() const { return sessions ? static_cast<double>(ruined) / static_cast<double>(sessions) : 0.0; }
+    double meanFinalBankroll() const { return sessions ? finalSum / static_cast<double>(sessions) : 0.0; }
+};
+
+struct SweepResult {
+    std::vector<SweepEntry> entries;      // best first: survivors by ruin estimate, then pruned ones
+    std::uint64_t totalSessions = 0;      // sessions actually simulated
+    std::uint64_t naiveSessions = 0;      // what the full grid would have cost
+    int rounds = 0;
+};
+
+struct SweepProgress { // A sweep between two rounds; entries are still in grid order
+    std::vector<SweepEntry> entries;
+    std::vector<std::size_t> live;        // indices into entries still receiving sessions
+    std::uint64_t done = 0, target = 0;   // sessions per live configuration so far, and after the next round
+    std::uint64_t totalSessions = 0;
+    int rounds = 0;
+};
+
+struct SweepCheckpointHook { // Round-by-round saves of a sweep
+    std::function<void(const SweepProgress&)> save; // after every round
+    bool resume = false;                  // start from `progress` instead of round one
+    SweepProgress progress;
+    std::string saveError;                // first failed save, if any; the sweep carries on
+};
+
+inline std::string describeConfig(const StrategyConfig& c) { // One-line summary of the swept settings
+    std::ostringstream os;
+    auto list = [&](const std::vector<double>& v, const char* empty) {
+        if (v.empty()) { os << empty; return; }
+        for (std::size_t i = 0; i < v.size(); ++i) os << (i ? " " : "") << v[i];
+    };
+    os << "thr " << c.lossThreshold << " | loss "; list(c.lossMultipliers, "3 3 2");
+    os << " | win "; list(c.winMultipliers, "reset");
+    os << " | bet $" << c.initialBet << " max $" << c.maxBet;
+    return os.str();
+}
+
+// After a round: stop configurations whose ruin interval lies wholly above the best one's
+inline void pruneSweep(std::vector<SweepEntry>& entries, std::vector<std::size_t>& live, int round, const SweepOptions& options) {
+    double bestUpper = 1.0, lo, hi;
+    for (std::size_t i : live) { // The best configuration is the one with the lowest upper bound
+        wilsonInterval(entries[i].ruined, entries[i].sessions, options.z, lo, hi);
+        bestUpper = std::min(bestUpper, hi);
+    }
+    std::vector<std::size_t> keep;
+    for (std::size_t i : live) {
+        wilsonInterval(entries[i].ruined, entries[i].sessions, options.z, lo, hi);
+        if (lo > bestUpper) entries[i].prunedInRound = round; // clearly worse than the best
+        else keep.push_back(i);
+    }
+    if (options.halving && keep.size() > 1) { // Successive halving on top of the interval test
+        std::stable_sort(keep.begin(), keep.end(), [&](std::size_t a, std::size_t b) {
+            return entries[a].ruinProbability() < entries[b].ruinProbability();
+        });
+        for (std::size_t k = (keep.size() + 1) / 2; k < keep.size(); ++k) entries[keep[k]].prunedInRound = round;
+        keep.resize((keep.size() + 1) / 2);
+    }
+    live.swap(keep);
+}
+
+// Best first: survivors by ruin estimate, then pruned configurations, the longest-lasting first
+inline void rankSweep(std::vector<SweepEntry>& entries) {
+    std::stable_sort(entries.begin(), entries.end(), [](const SweepEntry& a, const SweepEntry& b) {
+        if ((a.prunedInRound == 0) != (b.prunedInRound == 0)) return a.prunedInRound == 0;
+        if (a.prunedInRound != b.prunedInRound) return a.prunedInRound > b.prunedInRound; // lasted longer first
+        return a.ruinProbability() < b.ruinProbability();
+    });
+}
+
+// ============================================================================
+//  SweepRunner
+//  Round r plays sessions [done, target) of the shared stream space for every
+//  live configuration, so a survivor's samples are the same ones it would get
+//  in a single run of `target` sessions and the sweep is deterministic.
+// ============================================================================
+class SweepRunner { // Grid runner with early termination
+public:
+    explicit SweepRunner(SweepOptions opt) : options(opt) {}
+
+    // A resumed sweep picks up after the last saved round with the same standings, so it ends
+    // exactly where an uninterrupted one would
+    SweepResult run(const SweepGrid& grid) const {
+        SweepProgress p;
+        SweepCheckpointHook* const hook = options.checkpoint;
+        if (hook && hook->resume) {
+            p = hook->progress;
+            if (options.telemetry) options.telemetry->slot(0).addSessions(p.totalSessions, 0, 0);
+        }
+        else {
+            for (auto& c : grid.expand()) { SweepEntry e; e.config = std::move(c); p.entries.push_back(std::move(e)); }
+            for (std::size_t i = 0; i < p.entries.size(); ++i) p.live.push_back(i);
+            p.target = std::min(std::max<std::uint64_t>(options.firstRound, 1), options.maxSessions);
+        }
+
+        while (!p.live.empty() && p.done < options.maxSessions) {
+            ++p.rounds;
+            std::vector<StrategyConfig> configs; // Extend every survivor to `target` sessions in one shared pass
+            for (std::size_t i : p.live) configs.push_back(p.entries[i].config);
+            BatchOptions b;
+            b.sessions = p.target - p.done; b.firstSession = p.done;
+            b.masterSeed = options.masterSeed; b.generator = options.generator; b.threads = options.threads; b.telemetry = options.telemetry;
+            if (options.telemetry) // survivors all run to maxSessions unless pruned later
+                options.telemetry->setTarget(p.totalSessions + p.live.size() * (options.maxSessions - p.done));
+            const CrnResult r = CommonRandomEngine(configs).run(b);
+            for (std::size_t j = 0; j < p.live.size(); ++j) {
+                SweepEntry& e = p.entries[p.live[j]];
+                e.sessions += r.sessions; e.ruined += r.entries[j].ruined;
+                e.finalSum += r.entries[j].meanFinalBankroll * static_cast<double>(r.sessions);
+                p.totalSessions += r.sessions;
+            }
+            p.done = p.target;
+            if (p.done < options.maxSessions) prune(p.entries, p.live, p.rounds);
+            p.target = std::min(options.maxSessions, p.target * 2);
+            if (hook && hook->save) {
+                try { hook->save(p); }
+                catch (const std::exception& e) { if (hook->saveError.empty()) hook->saveError = e.what(); }
+            }
+        }
+
+        SweepResult out;
+        out.naiveSessions = options.maxSessions * p.entries.size();
+        out.entries = std::move(p.entries); out.totalSessions = p.totalSessions; out.rounds = p.rounds;
+        rankSweep(out.entries);
+        return out;
+    }
+
+private:
+    void prune(std::vector<SweepEntry>& entries, std::vector<std::size_t>& live, int round) const { pruneSweep(entries, live, round, options); }
+
+    SweepOptions options;
+};
+
+inline void printSweepResult(const SweepResult& r, std::ostream& os, std::size_t top = 10) { // Print the leaders
+    os << "\n===== Sweep Results =====\n"
+        << "Configurations: " << r.entries.size() << ", rounds: " << r.rounds << "\n"
+        << "Sessions simulated: " << r.totalSessions << " of " << r.naiveSessions << " for the full grid\n";
+    for (std::size_t i = 0; i < r.entries.size() && i < top; ++i) {
+        const SweepEntry& e = r.entries[i];
+        os << "  " << (i + 1) << ") " << describeConfig(e.config) << "\n"
+            << "     ruin " << (e.ruinProbability() * 100.0) << "%, mean $" << e.meanFinalBankroll()
+            << ", " << e.sessions << " sessions";
+        if (e.prunedInRound) os << " (pruned in round " << e.prunedInRound << ")";
+        os << "\n";
+    }
+    os << "=========================\n";
+}
@@ -0,0 +1,174 @@
+// ============================================================================
+//  Telemetry.h - live progress counters for long headless runs. Each worker
+//  thread bumps its own cache-line-padded slot with relaxed atomics once per
+//  chunk of sessions (256 in the batch engine); a reporter thread sums the
+//  slots once a second and prints rates, progress, the running ruin estimate
+//  and an ETA. Optional per-stage cycle counts (RNG, classify, strategy step,
+//  stats update) come from rdtsc.
+//  Build:  C++20, Visual Studio 2022 (x64, Windows)
+// ============================================================================
+#pragma once
+
+#include "StrategyKernel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+enum class Stage { RNG, CLASSIFY, STEP, STATS };
+constexpr std::size_t stageCount = 4;
+
+inline const char* stageName(Stage s) { // Short label for reports
+    switch (s) { case Stage::RNG: return "rng"; case Stage::CLASSIFY: return "classify"; case Stage::STEP: return "step"; case Stage::STATS: return "stats"; }
+    return "?";
+}
+
+inline std::uint64_t cycleCount() { // Time-stamp counter, or nanoseconds where there is none
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+struct StageCycles { // Per-session stage totals, kept in registers and flushed once
+    std::uint64_t cycles[stageCount] = {};
+    void add(Stage s, std::uint64_t c) { cycles[static_cast<std::size_t>(s)] += c; }
+};
+
+struct alignas(64) TelemetrySlot { // One worker's counters, on a cache line of their own
+    std::atomic<std::uint64_t> spins{ 0 }, sessions{ 0 }, ruined{ 0 };
+    std::atomic<std::uint64_t> cycles[stageCount] = {};
+
+    void addSession(const SessionResult& r) { addSessions(1, static_cast<std::uint64_t>(r.spins), r.ruined ? 1 : 0); }
+    void addSessions(std::uint64_t n, std::uint64_t spun, std::uint64_t ruins) {
+        sessions.fetch_add(n, std::memory_order_relaxed);
+        spins.fetch_add(spun, std::memory_order_relaxed);
+        if (ruins) ruined.fetch_add(ruins, std::memory_order_relaxed);
+    }
+    void addCycles(const StageCycles& c) {
+        for (std::size_t s = 0; s < stageCount; ++s) cycles[s].fetch_add(c.cycles[s], std::memory_order_relaxed);
+    }
+};
+
+struct TelemetrySnapshot { // Sum over all slots at one instant
+    std::uint64_t spins = 0, sessions = 0, ruined = 0, target = 0;
+    std::uint64_t cycles[stageCount] = {};
+};
+
+// ============================================================================
+//  Telemetry
+//  Shared by the engine's workers (through BatchOptions) and the reporter.
+//  Worker w writes slot w % slots; counters only grow, so a later run (the
+//  next sweep round) keeps adding to the same totals.
+// ============================================================================
+class Telemetry { // Per-thread progress counters
+public:
+    explicit Telemetry(std::uint64_t targetSessions = 0, unsigned slots = 0)
+        : slotsPerRun(slots ? slots : std::max(1u, std::thread::hardware_concurrency())), slotTable(slotsPerRun), goal(targetSessions) {}
+
+    TelemetrySlot& slot(unsigned worker) { return slotTable[worker % slotsPerRun]; }
+    void setTarget(std::uint64_t sessions) { goal.store(sessions, std::memory_order_relaxed); }
+    bool stageTiming = false;             // also count cycles per stage (scalar stepping only)
+
+    TelemetrySnapshot snapshot() const {
+        TelemetrySnapshot s;
+        for (const TelemetrySlot& t : slotTable) {
+            s.spins += t.spins.load(std::memory_order_relaxed);
+            s.sessions += t.sessions.load(std::memory_order_relaxed);
+            s.ruined += t.ruined.load(std::memory_order_relaxed);
+            for (std::size_t k = 0; k < stageCount; ++k) s.cycles[k] += t.cycles[k].load(std::memory_order_relaxed);
+        }
+        s.target = goal.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    unsigned slotsPerRun;
+    std::vector<TelemetrySlot> slotTable;
+    std::atomic<std::uint64_t> goal;
+};
+
+// ============================================================================
+//  ProgressReporter - samples a Telemetry every interval on its own thread
+//  and rewrites one status line; stop() (or the destructor) ends the line
+// ============================================================================
+class ProgressReporter { // Once-a-second status line
+public:
+    ProgressReporter(const Telemetry& t, std::ostream& os, std::chrono::milliseconds every = std::chrono::milliseconds(1000))
+        : telemetry(t), out(os), interval(every), started(std::chrono::steady_clock::now()) {
+        worker = std::thread([this] { loop(); });
+    }
+    ProgressReporter(const ProgressReporter&) = delete;
+    ProgressReporter& operator=(const ProgressReporter&) = delete;
+    ~ProgressReporter() { stop(); }
+
+    void stop() {
+        if (!worker.joinable()) return;
+        { std::lock_guard<std::mutex> lock(m); stopping = true; }
+        wake.notify_one();
+        worker.join();
+        if (printed) out << "\n";
+    }
+
+private:
+    void loop() {
+        TelemetrySnapshot last = telemetry.snapshot();
+        auto lastTime = started;
+        std::unique_lock<std::mutex> lock(m);
+        while (!wake.wait_for(lock, interval, [this] { return stopping; })) {
+            const TelemetrySnapshot now = telemetry.snapshot();
+            const auto t = std::chrono::steady_clock::now();
+            print(now, last, std::chrono::duration<double>(t - lastTime).count(), std::chrono::duration<double>(t - started).count());
+            last = now; lastTime = t;
+        }
+    }
+    void print(const TelemetrySnapshot& now, const TelemetrySnapshot& last, double dt, double elapsed) {
+        const double sessionRate = dt > 0 ? static_cast<double>(now.sessions - last.sessions) / dt : 0.0;
+        const double spinRate = dt > 0 ? static_cast<double>(now.spins - last.spins) / dt : 0.0;
+        const std::ios::fmtflags flags = out.flags();
+        const std::streamsize precision = out.precision();
+        out << "\r" << std::fixed << std::setprecision(1);
+        if (now.target) out << std::min(100.0, 100.0 * static_cast<double>(now.sessions) / static_cast<double>(now.target)) << "% | ";
+        out << now.sessions;
+        if (now.target) out << "/" << now.target;
+        out << " sessions | " << sessionRate / 1e3 << " k sessions/s | " << spinRate / 1e6 << " M spins/s";
+        if (now.sessions) out << " | ruin " << std::setprecision(2) << 100.0 * static_cast<double>(now.ruined) / static_cast<double>(now.sessions) << "%";
+        if (now.target > now.sessions && now.sessions && elapsed > 0) { // overall rate, steadier than the last second's
+            const auto eta = static_cast<std::uint64_t>(static_cast<double>(now.target - now.sessions) * elapsed / static_cast<double>(now.sessions));
+            out << " | ETA " << eta / 3600 << ":" << std::setfill('0') << std::setw(2) << eta / 60 % 60 << ":" << std::setw(2) << eta % 60 << std::setfill(' ');
+        }
+        if (telemetry.stageTiming && now.spins) {
+            out << " | cycles/spin" << std::setprecision(1);
+            for (std::size_t k = 0; k < stageCount; ++k)
+                out << " " << stageName(static_cast<Stage>(k)) << " " << static_cast<double>(now.cycles[k]) / static_cast<double>(now.spins);
+        }
+        out << "   ";
+        out.flush();
+        out.flags(flags); out.precision(precision);
+        printed = true;
+    }
+
+    const Telemetry& telemetry;
+    std::ostream& out;
+    std::chrono::milliseconds interval;
+    std::chrono::steady_clock::time_point started;
+    std::mutex m;
+    std::condition_variable wake;
+    bool stopping = false, printed = false;
+    std::thread worker;
+};
@@ -0,0 +1,288 @@
+// ============================================================================
+//  Wire.h - byte-level transport for distributed runs: a little-endian
+//  archive pair (one transfer() per type reads or writes every field),
+//  length-prefixed frames, and a minimal blocking TCP socket over Winsock or
+//  BSD sockets. Results that go over the wire are integer counts, raw sums and
+//  histogram buckets, so merging them on the far side is exact.
+//  Build:  C++20, Visual Studio 2022 (x64, Windows)
+// ============================================================================
+#pragma once
+
+#include "BetLayout.h"
+#include "SimulationEngine.h"
+#include "StatsSketch.h"
+#include "StrategyKernel.h"
+
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX                          // keep std::min / std::max usable after windows.h
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#ifdef _MSC_VER
+#pragma comment(lib, "Ws2_32.lib")
+#endif
+#else
+#include <cerrno>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+// ============================================================================
+//  Archives - WireWriter appends, WireReader consumes and throws on a short
+//  or malformed buffer. Both expose operator() for the same field types, so
+//  one transfer(ar, value) function serves both directions.
+// ============================================================================
+class WireWriter { // Serializes into a byte string
+public:
+    static constexpr bool loading = false;
+    template<class T> requires std::is_arithmetic_v<T>
+    void operator()(const T& v) {
+        if constexpr (std::is_floating_point_v<T>) putWord(std::bit_cast<std::uint64_t>(static_cast<double>(v)), 8);
+        else putWord(static_cast<std::uint64_t>(v), sizeof(T));
+    }
+    template<class T>
+    void operator()(const std::vector<T>& v) {
+        (*this)(static_cast<std::uint64_t>(v.size()));
+        for (const T& x : v) (*this)(x);
+    }
+    void operator()(const std::string& s) { (*this)(static_cast<std::uint64_t>(s.size())); bytes += s; }
+    const std::string& data() const { return bytes; }
+private:
+    void putWord(std::uint64_t w, std::size_t n) { for (std::size_t i = 0; i < n; ++i) bytes.push_back(static_cast<char>(w >> (8 * i))); }
+    std::string bytes;
+};
+
+class WireReader { // Deserializes from a byte string
+public:
+    static constexpr bool loading = true;
+    explicit WireReader(const std::string& b) : bytes(b) {}
+    template<class T> requires std::is_arithmetic_v<T>
+    void operator()(T& v) {
+        if constexpr (std::is_floating_point_v<T>) v = static_cast<T>(std::bit_cast<double>(getWord(8)));
+        else if constexpr (std::is_same_v<T, bool>) v = getWord(1) != 0;
+        else v = static_cast<T>(getWord(sizeof(T)));
+    }
+    template<class T>
+    void operator()(std::vector<T>& v) {
+        std::uint64_t n = 0; (*this)(n);
+        if (n > bytes.size() - pos) throw std::runtime_error("Malformed message: vector length"); // every element is at least one byte
+        v.resize(static_cast<std::size_t>(n));
+        for (T& x : v) (*this)(x);
+    }
+    void operator()(std::string& s) {
+        std::uint64_t n = 0; (*this)(n);
+        if (n > bytes.size() - pos) throw std::runtime_error("Malformed message: string length");
+        s.assign(bytes, pos, static_cast<std::size_t>(n)); pos += static_cast<std::size_t>(n);
+    }
+    bool finished() const { return pos == bytes.size(); }
+private:
+    std::uint64_t getWord(std::size_t n) {
+        if (bytes.size() - pos < n) throw std::runtime_error("Malformed message: truncated");
+        std::uint64_t w = 0;
+        for (std::size_t i = 0; i < n; ++i) w |= static_cast<std::uint64_t>(static_cast<unsigned char>(bytes[pos++])) << (8 * i);
+        return w;
+    }
+    const std::string& bytes;
+    std::size_t pos = 0;
+};
+
+// ----- transfer() for the types that cross the wire ---------------------------
+template<class Archive, class T> requires std::is_arithmetic_v<T>
+void transfer(Archive& ar, T& v) { ar(v); }
+template<class Archive>
+void transfer(Archive& ar, BetChip& c) {
+    auto kind = static_cast<std::uint8_t>(c.kind);
+    ar(kind); ar(c.number); ar(c.second); ar(c.amount);
+    if constexpr (Archive::loading) {
+        if (kind > static_cast<std::uint8_t>(BetKind::HIGH)) throw std::runtime_error("Malformed message: bet kind");
+        c.kind = static_cast<BetKind>(kind);
+    }
+}
+template<class Archive>
+void transfer(Archive& ar, BetLayout& l) { // Chip count, then each chip; loading re-checks every chip
+    std::vector<BetChip> chips = l.chips();
+    auto n = static_cast<std::uint64_t>(chips.size());
+    ar(n);
+    if constexpr (Archive::loading) {
+        l = BetLayout();
+        for (std::uint64_t i = 0; i < n; ++i) { BetChip c; transfer(ar, c); l.add(c); }
+    }
+    else for (BetChip& c : chips) transfer(ar, c);
+}
+template<class Archive>
+void transfer(Archive& ar, StrategyConfig& c) {
+    ar(c.bankroll); ar(c.lossThreshold); ar(c.lossMultipliers); ar(c.winMultipliers);
+    ar(c.extraBet); ar(c.initialBet); ar(c.maxBet);
+    auto wheel = static_cast<std::uint8_t>(c.wheel);
+    ar(wheel);
+    if constexpr (Archive::loading) {
+        if (wheel > static_cast<std::uint8_t>(WheelKind::TRIPLE_ZERO)) throw std::runtime_error("Malformed message: wheel kind");
+        c.wheel = static_cast<WheelKind>(wheel);
+    }
+    transfer(ar, c.sideBets);
+    ar(c.program);
+}
+template<class Archive>
+void transfer(Archive& ar, SessionSketch& s) {
+    s.finalBankroll.transfer(ar); s.longestLossStreak.transfer(ar); s.spinsToRuin.transfer(ar);
+}
+template<class Archive>
+void transfer(Archive& ar, BatchResult& r) { // Raw counters, sums and sketch; derived fields are recomputed
+    ar(r.sessions); ar(r.ruined); ar(r.sessionsHittingMaxBet); ar(r.maxBetHits); ar(r.totalSpins);
+    ar(r.finalSum); ar(r.finalSumSq);
+    transfer(ar, r.distribution);
+    if constexpr (Archive::loading) finishBatchResult(r);
+}
+
+// ============================================================================
+//  Socket - one blocking TCP connection or listener. Frames are a 4-byte
+//  little-endian length and a payload; anything over maxFrame is treated as a
+//  broken peer. Every failure throws std::runtime_error.
+// ============================================================================
+class Socket { // Move-only TCP socket
+public:
+#ifdef _WIN32
+    using Handle = SOCKET;
+    static constexpr Handle invalid = INVALID_SOCKET;
+#else
+    using Handle = int;
+    static constexpr Handle invalid = -1;
+#endif
+    static constexpr std::uint32_t maxFrame = 256u << 20;
+
+    Socket() = default;
+    explicit Socket(Handle h) : handle(h) {}
+    Socket(Socket&& o) noexcept : handle(std::exchange(o.handle, invalid)) {}
+    Socket& operator=(Socket&& o) noexcept { if (this != &o) { close(); handle = std::exchange(o.handle, invalid); } return *this; }
+    ~Socket() { close(); }
+
+    static Socket connect(const std::string& host, std::uint16_t port) { // Resolve and connect, IPv4 or IPv6
+        startup();
+        addrinfo hints{}, * found = nullptr;
+        hints.ai_family = AF_UNSPEC; hints.ai_socktype = SOCK_STREAM;
+        if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &found) != 0 || !found)
+            throw std::runtime_error("Cannot resolve " + host);
+        Socket s;
+        for (addrinfo* a = found; a && !s.valid(); a = a->ai_next) {
+            Socket attempt(::socket(a->ai_family, a->ai_socktype, a->ai_protocol));
+            if (attempt.valid() && ::connect(attempt.handle, a->ai_addr, static_cast<int>(a->ai_addrlen)) == 0) s = std::move(attempt);
+        }
+        freeaddrinfo(found);
+        if (!s.valid()) throw std::runtime_error("Cannot connect to " + host + ":" + std::to_string(port));
+        s.noDelay();
+        return s;
+    }
+    static Socket listen(std::uint16_t port) { // All interfaces, IPv4
+        startup();
+        Socket s(::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP));
+        if (!s.valid()) throw std::runtime_error("Cannot create a socket");
+        const int yes = 1;
+        setsockopt(s.handle, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&yes), sizeof yes);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET; addr.sin_addr.s_addr = htonl(INADDR_ANY); addr.sin_port = htons(port);
+        if (::bind(s.handle, reinterpret_cast<const sockaddr*>(&addr), sizeof addr) != 0 || ::listen(s.handle, SOMAXCONN) != 0)
+            throw std::runtime_error("Cannot listen on port " + std::to_string(port));
+        return s;
+    }
+
+    // Next connection, or an invalid socket if none arrives within `wait`
+    Socket accept(std::chrono::milliseconds wait) const {
+        if (!readable(wait)) return Socket();
+        Socket c(::accept(handle, nullptr, nullptr));
+        if (c.valid()) c.noDelay();
+        return c;
+    }
+    void setReceiveTimeout(std::chrono::milliseconds t) const { // 0 = wait forever
+#ifdef _WIN32
+        const DWORD ms = static_cast<DWORD>(t.count());
+        setsockopt(handle, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&ms), sizeof ms);
+#else
+        timeval tv{ static_cast<time_t>(t.count() / 1000), static_cast<suseconds_t>(t.count() % 1000 * 1000) };
+        setsockopt(handle, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof tv);
+#endif
+    }
+
+    void sendFrame(const std::string& payload) const {
+        if (payload.size() > maxFrame) throw std::runtime_error("Message too large");
+        const auto n = static_cast<std::uint32_t>(payload.size());
+        const char header[4] = { static_cast<char>(n), static_cast<char>(n >> 8), static_cast<char>(n >> 16), static_cast<char>(n >> 24) };
+        sendAll(header, 4); sendAll(payload.data(), payload.size());
+    }
+    std::string receiveFrame() const {
+        unsigned char header[4];
+        receiveAll(reinterpret_cast<char*>(header), 4);
+        const std::uint32_t n = header[0] | (header[1] << 8) | (header[2] << 16) | (static_cast<std::uint32_t>(header[3]) << 24);
+        if (n > maxFrame) throw std::runtime_error("Message too large");
+        std::string payload(n, '\0');
+        receiveAll(payload.data(), n);
+        return payload;
+    }
+
+    bool valid() const { return handle != invalid; }
+    void close() {
+        if (!valid()) return;
+#ifdef _WIN32
+        closesocket(handle);
+#else
+        ::close(handle);
+#endif
+        handle = invalid;
+    }
+
+private:
+    static void startup() { // Winsock needs one WSAStartup per process
+#ifdef _WIN32
+        static const bool started = [] { WSADATA d; return WSAStartup(MAKEWORD(2, 2), &d) == 0; }();
+        if (!started) throw std::runtime_error("WSAStartup failed");
+#endif
+    }
+    void noDelay() const { // frames are small and answered at once
+        const int yes = 1;
+        setsockopt(handle, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&yes), sizeof yes);
+    }
+    bool readable(std::chrono::milliseconds wait) const {
+        fd_set set; FD_ZERO(&set); FD_SET(handle, &set);
+        timeval tv{ static_cast<long>(wait.count() / 1000), static_cast<long>(wait.count() % 1000 * 1000) };
+        return ::select(static_cast<int>(handle + 1), &set, nullptr, nullptr, &tv) > 0;
+    }
+    void sendAll(const char* p, std::size_t n) const {
+        while (n) {
+#if defined(MSG_NOSIGNAL)
+            const auto k = ::send(handle, p, n, MSG_NOSIGNAL); // a dead peer is an error, not SIGPIPE
+#else
+            const auto k = ::send(handle, p, static_cast<int>(n), 0);
+#endif
+            if (k <= 0) throw std::runtime_error("Connection lost while sending");
+            p += k; n -= static_cast<std::size_t>(k);
+        }
+    }
+    void receiveAll(char* p, std::size_t n) const {
+        while (n) {
+#ifdef _WIN32
+            const auto k = ::recv(handle, p, static_cast<int>(n), 0);
+#else
+            const auto k = ::recv(handle, p, n, 0);
+#endif
+            if (k <= 0) throw std::runtime_error(k == 0 ? "Connection closed" : "Connection lost or timed out");
+            p += k; n -= static_cast<std::size_t>(k);
+        }
+    }
+
+    Handle handle = invalid;
+};
@@ -0,0 +1,534 @@
+// ============================================================================
+//  Roulette Tests.cpp - checks for the promises the engines make to each
+//  other: lanes and scalar stepping agree, CRN sweeps equal independent
+//  batches, resumed checkpoints equal uninterrupted runs, programs replay the
+//  kernel, the exact evaluator agrees with sampling, spin logs round-trip,
+//  bet layouts cover the right pockets, and job settings parse or fail.
+//  Usage: "Roulette Tests" [group]...   (no group = all; see `groups` below)
+//  Build:  C++20, Visual Studio 2022 (x64, Windows)
+// ============================================================================
+
+// ----- Standard C++ headers -------------------------------------------------
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// ----- Project headers ------------------------------------------------------
+#include "BetLayout.h"
+#include "Checkpoint.h"
+#include "CommonRandomEngine.h"
+#include "CpuDispatch.h"
+#include "JobRunner.h"
+#include "MarkovEvaluator.h"
+#include "RouletteCore.h"
+#include "SimulationEngine.h"
+#include "SpinLog.h"
+#include "StrategyKernel.h"
+#include "StrategyProgram.h"
+#include "SweepRunner.h"
+
+// ============================================================================
+//  Harness - a group is a function that reports failed checks; main() runs
+//  the groups named on the command line and exits non-zero if any check failed
+// ============================================================================
+static int failures = 0;
+
+void check(bool ok, const std::string& what) {
+    if (ok) return;
+    ++failures;
+    std::cout << "  FAILED: " << what << "\n";
+}
+
+template<class Exception = std::invalid_argument, class Body>
+void checkThrows(Body&& body, const std::string& what) { // body must throw Exception
+    try { body(); }
+    catch (const Exception&) { return; }
+    catch (const std::exception& e) { check(false, what + " (threw something else: " + e.what() + ")"); return; }
+    check(false, what + " (did not throw)");
+}
+
+std::string tempPath(const std::string& name) { // a file in the temp directory, gone before use
+    const std::filesystem::path p = std::filesystem::temp_directory_path() / ("roulette-tests-" + name);
+    std::error_code e;
+    std::filesystem::remove(p, e);
+    return p.string();
+}
+
+bool sameSession(const SessionResult& a, const SessionResult& b) {
+    return a.finalBankroll == b.finalBankroll && a.spins == b.spins && a.maxBetHits == b.maxBetHits
+        && a.longestLossStreak == b.longestLossStreak && a.ruined == b.ruined;
+}
+
+bool sameBatch(const BatchResult& a, const BatchResult& b) { // bit for bit, sketch quantiles included
+    return a.sessions == b.sessions && a.ruined == b.ruined && a.totalSpins == b.totalSpins
+        && a.maxBetHits == b.maxBetHits && a.sessionsHittingMaxBet == b.sessionsHittingMaxBet
+        && a.finalSum == b.finalSum && a.finalSumSq == b.finalSumSq && a.meanFinalBankroll == b.meanFinalBankroll
+        && a.p05 == b.p05 && a.p25 == b.p25 && a.median == b.median && a.p75 == b.p75 && a.p95 == b.p95
+        && a.distribution.longestLossStreak.quantile(0.95) == b.distribution.longestLossStreak.quantile(0.95);
+}
+
+StrategyConfig testConfig() { // Small bets, so sessions last long enough to exercise the cap and the color switch
+    StrategyConfig c;
+    c.bankroll = 1000.0; c.initialBet = 10.0; c.maxBet = 500.0;
+    return c;
+}
+
+std::vector<std::pair<std::string, StrategyConfig>> testConfigs() { // One per kernel path worth telling apart
+    std::vector<std::pair<std::string, StrategyConfig>> out;
+    out.emplace_back("default", testConfig());
+    StrategyConfig wins = testConfig(); wins.winMultipliers = { 1, 2, 3 }; wins.lossThreshold = 2;
+    out.emplace_back("win multipliers", wins);
+    StrategyConfig extra = testConfig(); extra.extraBet = true; extra.wheel = WheelKind::EUROPEAN;
+    out.emplace_back("extra bet, european", extra);
+    StrategyConfig sided = testConfig(); sided.sideBets = BetLayout::parse("straight 17 1; split 8 9 1; dozen 2 1; odd 1");
+    sided.wheel = WheelKind::TRIPLE_ZERO;
+    out.emplace_back("side bets, triple zero", sided);
+    StrategyConfig pinned = testConfig(); pinned.lossMultipliers = { 4 }; pinned.winMultipliers = { 60 }; pinned.bankroll = 20000.0;
+    out.emplace_back("pinned at max bet", pinned);
+    return out;
+}
+
+// ============================================================================
+//  Groups
+// ============================================================================
+
+// SessionLanes against one-session-at-a-time stepping, for every generator; run once per
+// ROULETTE_SIMD level so each vector path is compared (see CMakeLists.txt)
+void testLanes() {
+    std::cout << "  SIMD path: " << simdLevelName(simdLevel()) << "\n";
+    auto configs = testConfigs();
+    StrategyConfig atCap = testConfig(); atCap.initialBet = 100.0; atCap.maxBet = 100.0; // a reset after a win is not a cap hit
+    configs.emplace_back("opening bet at the cap", atCap);
+    StrategyConfig aboveCap = atCap; aboveCap.initialBet = 200.0;
+    configs.emplace_back("opening bet above the cap", aboveCap);
+    StrategyConfig aboveCapWins = aboveCap; aboveCapWins.winMultipliers = { 1, 2 };
+    configs.emplace_back("opening bet above the cap, win multipliers", aboveCapWins);
+    for (const auto& [name, config] : configs)
+        for (GeneratorKind g : { GeneratorKind::XOSHIRO256X8, GeneratorKind::XOSHIRO256PP, GeneratorKind::PHILOX4X32, GeneratorKind::MT19937 })
+            for (unsigned threads : { 1u, 3u }) {
+                BatchOptions opt;
+                opt.sessions = 5000; opt.masterSeed = 7; opt.firstSession = 100; opt.generator = g; opt.threads = threads;
+                opt.stepping = SteppingMode::SCALAR;
+                const BatchResult scalar = SimulationEngine(config).run(opt);
+                opt.stepping = SteppingMode::LANES;
+                const BatchResult lanes = SimulationEngine(config).run(opt);
+                check(sameBatch(scalar, lanes), "lanes == scalar: " + name + ", " + generatorKindToString(g) + ", " + std::to_string(threads) + " threads");
+            }
+}
+
+// Common random numbers, alone and inside a sweep that prunes nothing, against one batch per configuration
+void testCrn() {
+    SweepGrid grid;
+    grid.bankroll = 1000.0;
+    grid.lossThresholds = { 2, 3 };
+    grid.lossMultiplierSets = { {}, { 2, 2, 2 } };
+    grid.winMultiplierSets = { {}, { 1, 2 } };
+    grid.initialBets = { 10.0 };
+    grid.maxBets = { 500.0 };
+    const std::vector<StrategyConfig> configs = grid.expand();
+
+    BatchOptions opt;
+    opt.sessions = 4000; opt.masterSeed = 21; opt.threads = 2;
+    const CrnResult crn = CommonRandomEngine(configs).run(opt);
+    check(crn.sessions == opt.sessions && crn.entries.size() == configs.size(), "CRN covers every configuration");
+
+    SweepOptions sweep;
+    sweep.maxSessions = opt.sessions; sweep.firstRound = 1000; sweep.z = 1e6; // intervals too wide to prune anything
+    sweep.masterSeed = opt.masterSeed; sweep.threads = 2;
+    const SweepResult swept = SweepRunner(sweep).run(grid);
+
+    for (std::size_t k = 0; k < configs.size(); ++k) {
+        const BatchResult single = SimulationEngine(configs[k]).run(opt);
+        const CrnEntry& e = crn.entries[k];
+        const std::string what = "configuration " + std::to_string(k) + " (" + describeConfig(configs[k]) + ")";
+        check(e.ruined == single.ruined && e.totalSpins == single.totalSpins && e.maxBetHits == single.maxBetHits
+            && e.sessionsHittingMaxBet == single.sessionsHittingMaxBet, "CRN counters == independent batch: " + what);
+        check(std::fabs(e.meanFinalBankroll - single.meanFinalBankroll) <= 1e-9 * std::fabs(single.meanFinalBankroll),
+            "CRN mean == independent batch: " + what);
+
+        bool found = false;
+        for (const SweepEntry& s : swept.entries) {
+            if (describeConfig(s.config) != describeConfig(configs[k])) continue;
+            found = true;
+            check(s.sessions == single.sessions && s.ruined == single.ruined && s.prunedInRound == 0, "sweep entry == independent batch: " + what);
+            check(std::fabs(s.meanFinalBankroll() - single.meanFinalBankroll) <= 1e-9 * std::fabs(single.meanFinalBankroll),
+                "sweep mean == independent batch: " + what);
+        }
+        check(found, "sweep has " + what);
+    }
+}
+
+// A batch resumed from a partial snapshot, or from its own finished checkpoint file, and a sweep
+// resumed after its first round, all against the run that was never interrupted
+void testCheckpoint() {
+    const StrategyConfig config = testConfig();
+    BatchOptions opt;
+    opt.sessions = 10 * SimulationEngine::chunkSize + 17; opt.masterSeed = 5; opt.threads = 3;
+    const SimulationEngine engine(config);
+    const BatchResult whole = engine.run(opt);
+
+    BatchCheckpointHook hook; // chunks 0, 2 and 7 "finished by an earlier run", each played as its own batch
+    for (std::uint64_t c : { 0u, 2u, 7u }) {
+        BatchOptions part = opt;
+        part.firstSession = c * SimulationEngine::chunkSize; part.sessions = SimulationEngine::chunkSize;
+        const BatchResult r = engine.run(part);
+        hook.resume.chunks.push_back(c);
+        hook.resume.chunkSums.push_back(r.finalSum); hook.resume.chunkSquares.push_back(r.finalSumSq);
+        mergeBatchResult(hook.resume.partial, r);
+    }
+    BatchOptions resumed = opt;
+    resumed.checkpoint = &hook;
+    check(sameBatch(engine.run(resumed), whole), "batch resumed from a snapshot == uninterrupted batch");
+
+    const std::string path = tempPath("batch.ck");
+    {
+        BatchCheckpoint file(path, config, opt);
+        BatchOptions saving = opt;
+        saving.checkpoint = file.hook();
+        check(sameBatch(engine.run(saving), whole), "checkpointed batch == uninterrupted batch");
+        check(file.hook()->saveError.empty(), "checkpoint saved: " + file.hook()->saveError);
+    }
+    {
+        BatchCheckpoint file(path, config, opt);
+        check(file.resumedSessions() == opt.sessions, "finished checkpoint reloads every session");
+        BatchOptions again = opt;
+        again.checkpoint = file.hook();
+        check(sameBatch(engine.run(again), whole), "batch resumed from its file == uninterrupted batch");
+    }
+    BatchOptions other = opt;
+    other.masterSeed = 6;
+    checkThrows<std::runtime_error>([&] { BatchCheckpoint mismatched(path, config, other); }, "checkpoint of another run is refused");
+    BatchOptions scalar = opt;
+    scalar.stepping = SteppingMode::SCALAR;
+    checkThrows<std::runtime_error>([&] { BatchCheckpoint mismatched(path, config, scalar); }, "checkpoint written under the other stepping is refused");
+    std::filesystem::remove(path);
+
+    SweepGrid grid;
+    grid.lossThresholds = { 1, 2, 3, 4 };
+    grid.initialBets = { 10.0, 50.0 };
+    grid.maxBets = { 500.0 };
+    SweepOptions sweep;
+    sweep.maxSessions = 8000; sweep.firstRound = 500; sweep.masterSeed = 9; sweep.threads = 2;
+    SweepCheckpointHook first; // keeps the standings after round one
+    SweepProgress afterRoundOne;
+    first.save = [&](const SweepProgress& p) { if (p.rounds == 1) afterRoundOne = p; };
+    SweepOptions saving = sweep;
+    saving.checkpoint = &first;
+    const SweepResult wholeSweep = SweepRunner(saving).run(grid);
+    SweepCheckpointHook later;
+    later.resume = true; later.progress = afterRoundOne;
+    SweepOptions resuming = sweep;
+    resuming.checkpoint = &later;
+    const SweepResult resumedSweep = SweepRunner(resuming).run(grid);
+    bool same = wholeSweep.rounds == resumedSweep.rounds && wholeSweep.totalSessions == resumedSweep.totalSessions
+        && wholeSweep.entries.size() == resumedSweep.entries.size();
+    for (std::size_t k = 0; same && k < wholeSweep.entries.size(); ++k) {
+        const SweepEntry& a = wholeSweep.entries[k];
+        const SweepEntry& b = resumedSweep.entries[k];
+        same = a.sessions == b.sessions && a.ruined == b.ruined && a.finalSum == b.finalSum && a.prunedInRound == b.prunedInRound;
+    }
+    check(afterRoundOne.rounds == 1, "sweep saved after round one");
+    check(wholeSweep.rounds > 1, "sweep ran more than one round");
+    check(same, "sweep resumed after round one == uninterrupted sweep");
+}
+
+// multiplierStrategySource() through the bytecode machine against the native kernel, bit for bit
+void testProgram() {
+    for (const auto& [name, config] : testConfigs()) {
+        StrategyConfig scripted = config;
+        scripted.program = multiplierStrategySource(config);
+        BatchOptions opt;
+        opt.sessions = 5000; opt.masterSeed = 13; opt.stepping = SteppingMode::SCALAR; opt.threads = 2;
+        check(sameBatch(SimulationEngine(config).run(opt), SimulationEngine(scripted).run(opt)), "program == kernel: " + name);
+    }
+    for (const char* preset : { "martingale", "fibonacci", "dalembert", "labouchere" }) {
+        bool compiled = true;
+        try { (void)StrategyProgram::compile(presetStrategySource(preset)); }
+        catch (const std::invalid_argument&) { compiled = false; }
+        check(compiled, std::string("preset compiles: ") + preset);
+    }
+    checkThrows([] { StrategyProgram::compile("loss: bet = bet *"); }, "incomplete expression is a compile error");
+    checkThrows([] { StrategyProgram::compile("bet = 1"); }, "statement before a section is a compile error");
+    checkThrows([] { StrategyProgram::compile("win: spins = 1"); }, "read-only variable is a compile error");
+    checkThrows([] { StrategyProgram::compile("loss: push 1\nalways: push 2 if won"); }, "two pushes in one spin are a compile error");
+}
+
+// The Markov-chain evaluation against a large sampled batch: within four standard errors plus
+// the evaluator's own truncation bound
+void testMarkov() {
+    for (const auto& [name, config] : testConfigs()) {
+        if (!config.sideBets.empty() || config.lossMultipliers.size() == 1) continue; // keep the state space small
+        const ExactEvaluation exact = MarkovEvaluator(config).evaluate();
+        BatchOptions opt;
+        opt.sessions = 200000; opt.masterSeed = 17;
+        const BatchResult sampled = SimulationEngine(config).run(opt);
+        const double p = exact.ruinProbability;
+        const double ruinTolerance = 4.0 * std::sqrt(std::max(p * (1 - p), 1e-6) / static_cast<double>(opt.sessions)) + exact.truncatedMass;
+        const double meanTolerance = 4.0 * sampled.meanStdErr + exact.meanErrorBound;
+        check(std::fabs(sampled.ruinProbability - p) <= ruinTolerance, "Markov ruin within tolerance of Monte Carlo: " + name);
+        check(std::fabs(sampled.meanFinalBankroll - exact.meanFinalBankroll) <= meanTolerance, "Markov mean within tolerance of Monte Carlo: " + name);
+        const double sampledSpins = static_cast<double>(sampled.totalSpins) / static_cast<double>(sampled.sessions);
+        check(sampledSpins >= 0.98 * exact.meanSpins && sampledSpins <= 1.02 * (exact.meanSpins + exact.meanSpinsErrorBound),
+            "Markov mean spins within 2% of Monte Carlo: " + name);
+
+        EvaluatorOptions coarse;
+        coarse.pruneBelow = 1e-6; // prunes far more mass than the default
+        const ExactEvaluation pruned = MarkovEvaluator(config, coarse).evaluate();
+        check(pruned.truncatedMass > exact.truncatedMass && pruned.meanSpins <= exact.meanSpins
+            && exact.meanSpins <= pruned.meanSpins + pruned.meanSpinsErrorBound, "pruned mean spins bracket the finer evaluation: " + name);
+    }
+}
+
+// Record, read back, replay, and refuse damaged files
+void testSpinLog() {
+    const std::string path = tempPath("log.rspl");
+    const std::uint64_t spins = 100000 + 1; // not a whole number of words
+    for (WheelKind wheel : { WheelKind::EUROPEAN, WheelKind::AMERICAN, WheelKind::TRIPLE_ZERO }) {
+        const std::string name = std::string("wheel with ") + std::to_string(wheelPocketCount(wheel)) + " pockets";
+        check(recordSpinLog(path, GeneratorKind::PHILOX4X32, 3, 40, spins, wheel) == spins, "recorded every spin: " + name);
+        const SpinLogReader log(path);
+        check(log.header().masterSeed == 3 && log.header().stream == 40 && log.spins() == spins && log.wheel() == wheel
+            && log.header().generator == static_cast<std::uint16_t>(GeneratorKind::PHILOX4X32), "header round trip: " + name);
+        check(std::filesystem::file_size(path) == sizeof(SpinLogHeader) + (spins + 2) / 3 * 2, "three spins per word: " + name);
+
+        std::vector<std::uint8_t> live(static_cast<std::size_t>((spins + 63) / 64 * 64)), played(static_cast<std::size_t>(spins));
+        withWheelLayout(wheel, [&](auto layout) {
+            BasicRouletteWheel<Philox4x32, decltype(layout)> w(3, 40);
+            for (std::size_t k = 0; k < live.size(); k += 64) w.spinBatch(std::span<std::uint8_t>(live.data() + k, 64));
+            return 0;
+        });
+        SpinLogWheel replay(log);
+        replay.spinBatch(played);
+        check(std::equal(played.begin(), played.end(), live.begin()), "replayed pockets == live stream: " + name);
+        check(replay.remaining() == 0, "replay used the whole log: " + name);
+        checkThrows<std::out_of_range>([&] { replay.spinIndex(); }, "reading past the end throws: " + name);
+
+        StrategyConfig config = testConfig();
+        config.wheel = wheel;
+        SessionResult first;
+        bool haveFirst = false;
+        const std::uint64_t sessions = replaySessions(log, config, [&](const SessionResult& r) { if (!haveFirst) { first = r; haveFirst = true; } });
+        const SessionResult expected = withWheelLayout(wheel, [&](auto layout) {
+            BasicRouletteWheel<Philox4x32, decltype(layout)> w(3, 40);
+            return SimulationEngine(config).runSession(w);
+        });
+        check(sessions > 1 && haveFirst && sameSession(first, expected), "first replayed session == the live session: " + name);
+        check(replayBatch(log, config).sessions == sessions, "replayBatch counts the same sessions: " + name);
+    }
+    {
+        StrategyConfig config = testConfig();
+        const SpinLogReader log(path);
+        config.wheel = WheelKind::AMERICAN;
+        checkThrows([&] { replaySessions(log, config, [](const SessionResult&) {}); }, "replay on another wheel is refused");
+    }
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 10);
+    checkThrows<std::runtime_error>([&] { SpinLogReader log(path); }, "truncated log is refused");
+    { std::ofstream bad(path, std::ios::binary | std::ios::trunc); bad << "not a spin log, just some text to fill a header"; }
+    checkThrows<std::runtime_error>([&] { SpinLogReader log(path); }, "file without the magic is refused");
+    recordSpinLog(path, GeneratorKind::XOSHIRO256X8, 1, 0, 30);
+    {
+        std::fstream poke(path, std::ios::binary | std::ios::in | std::ios::out);
+        poke.seekp(sizeof(SpinLogHeader));
+        const std::uint16_t invalid = 0xFFFF; // past 38^3
+        poke.write(reinterpret_cast<const char*>(&invalid), sizeof invalid);
+    }
+    checkThrows<std::runtime_error>([&] { SpinLogReader log(path); }, "word outside the wheel is refused");
+    std::filesystem::remove(path);
+}
+
+// Pockets each chip covers, the payout table it compiles to, and the bets that are not on the table
+void testBetLayout() {
+    auto pockets = [](std::initializer_list<int> list) { std::uint64_t m = 0; for (int n : list) m |= 1ull << n; return m; };
+    check(betCoverage({ BetKind::STRAIGHT, 17, 0, 1 }) == pockets({ 17 }), "straight 17");
+    check(betCoverage({ BetKind::STRAIGHT, 37, 0, 1 }) == pockets({ 37 }), "straight 00");
+    check(betCoverage({ BetKind::SPLIT, 8, 9, 1 }) == pockets({ 8, 9 }), "split 8 9");
+    check(betCoverage({ BetKind::SPLIT, 20, 23, 1 }) == pockets({ 20, 23 }), "split 20 23");
+    check(betCoverage({ BetKind::STREET, 13, 0, 1 }) == pockets({ 13, 14, 15 }), "street 13");
+    check(betCoverage({ BetKind::CORNER, 25, 0, 1 }) == pockets({ 25, 26, 28, 29 }), "corner 25");
+    check(betCoverage({ BetKind::DOZEN, 2, 0, 1 }) == pockets({ 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24 }), "dozen 2");
+    check(betCoverage({ BetKind::COLUMN, 3, 0, 1 }) == pockets({ 3, 6, 9, 12, 15, 18, 21, 24, 27, 30, 33, 36 }), "column 3");
+    check(betCoverage({ BetKind::RED, 0, 0, 1 }) == redPocketMask, "red");
+    check(betCoverage({ BetKind::BLACK, 0, 0, 1 }) == (((1ull << 37) - 2) & ~redPocketMask), "black");
+    check(std::popcount(betCoverage({ BetKind::ODD, 0, 0, 1 })) == 18 && std::popcount(betCoverage({ BetKind::EVEN, 0, 0, 1 })) == 18, "odd and even");
+    check(betCoverage({ BetKind::LOW, 0, 0, 1 }) == ((1ull << 19) - 2), "low");
+    check((betCoverage({ BetKind::LOW, 0, 0, 1 }) | betCoverage({ BetKind::HIGH, 0, 0, 1 })) == (1ull << 37) - 2, "low and high cover 1-36");
+
+    const BetLayout layout = BetLayout::parse("straight 17 2; split 8 9 1; dozen 2 1.5; red 1");
+    check(layout.chips().size() == 4 && layout.stake() == 5.5, "parse reads every chip");
+    const auto table = compilePayouts(layout, WheelKind::EUROPEAN);
+    check(table.net[17] == 2 * 35 - 1 + 1.5 * 2 - 1 && table.net[0] == -5.5, "payouts for pocket 17 (black) and the zero");
+    double expected = 0;
+    for (int n = 0; n < 37; ++n) expected += table.net[n];
+    check(std::fabs(expected / 37 + 5.5 / 37) < 1e-12, "european layout loses 1/37 of the stake");
+    check(!table.greenOnly, "table with number bets is not green-only");
+    check(compilePayouts(BetLayout::zeros(2, 1.0), WheelKind::AMERICAN).greenOnly, "chips on the zeros are green-only");
+
+    checkThrows([] { BetLayout::parse("split 8 10 1"); }, "split of numbers that do not touch");
+    checkThrows([] { BetLayout::parse("street 2 1"); }, "street that does not start a row");
+    checkThrows([] { BetLayout::parse("corner 3 1"); }, "corner in the third column");
+    checkThrows([] { BetLayout::parse("dozen 4 1"); }, "fourth dozen");
+    checkThrows([] { BetLayout::parse("column 0 1"); }, "column 0");
+    checkThrows([] { BetLayout::parse("straight 17"); }, "chip without an amount");
+    checkThrows([] { BetLayout::parse("straight 17 -1"); }, "negative amount");
+    checkThrows([] { BetLayout::parse("straight x 1"); }, "pocket that is not a number");
+    checkThrows([] { BetLayout::parse("parlay 3 1"); }, "unknown bet kind");
+    checkThrows([] { compilePayouts(BetLayout::parse("straight 00 1"), WheelKind::EUROPEAN); }, "00 on a european wheel");
+}
+
+// applyJobSetting() and readJobFile() take what they document and refuse the rest
+void testJobs() {
+    JobSettings s;
+    applyJobSetting(s, "mode", "sweep");
+    applyJobSetting(s, "strategy.bankroll", "2500");
+    applyJobSetting(s, "run.sessions", "1000");
+    applyJobSetting(s, "loss", "3, 3, 2");
+    applyJobSetting(s, "sweep.loss_sets", "3 3 2; 2 2 2");
+    applyJobSetting(s, "sweep.win_sets", "; 1 2");
+    applyJobSetting(s, "extra", "yes");
+    applyJobSetting(s, "wheel", "triple");
+    check(s.mode == JobMode::SWEEP && s.config.bankroll == 2500 && s.batch.sessions == 1000, "plain and prefixed keys");
+    check(s.config.lossMultipliers == std::vector<double>{ 3, 3, 2 }, "comma-separated list");
+    check(s.sweepLossSets.size() == 2 && s.sweepLossSets[1] == std::vector<double>{ 2, 2, 2 }, "list sets");
+    check(s.sweepWinSets.size() == 2 && s.sweepWinSets[0].empty() && s.sweepWinSets[1] == std::vector<double>{ 1, 2 }, "empty first list set");
+    check(s.config.extraBet && s.config.wheel == WheelKind::TRIPLE_ZERO, "flags and choices");
+
+    const std::pair<const char*, const char*> refused[] = {
+        { "speed", "fast" }, { "mode", "turbo" }, { "threshold", "0" }, { "sessions", "12x" }, { "sessions", "-5" },
+        { "bankroll", "-5" }, { "bankroll", "inf" }, { "extra", "maybe" }, { "loss", "3 x 2" }, { "wheel", "mars" },
+        { "importance.cap_run", "-1" }, { "importance.loss_streak", "0" }, { "exact.resolution", "-1" }, { "exact.prune_below", "-1" },
+        { "side_bets", "split 8 10 1" }, { "program", "loss: bet = bet *" }, { "coordinator", "70000" },
+    };
+    for (const auto& [key, value] : refused) {
+        JobSettings t;
+        checkThrows([&] { applyJobSetting(t, key, value); }, std::string("refuses ") + key + " = " + value);
+    }
+
+    const std::string path = tempPath("job.toml");
+    {
+        std::ofstream f(path);
+        f << "# a sweep\nmode = \"sweep\"\nsessions = 500  # per configuration\nseed = 4\n"
+            << "[strategy]\nbankroll = 1500\nextra = true\n"
+            << "[sweep]\nthresholds = [2, 3]\nloss_sets = [[3, 3, 2],\n   [2, 2]]\nwin_sets = [[], [1, 2]]\n";
+    }
+    JobSettings fromFile;
+    readJobFile(path, fromFile);
+    check(fromFile.mode == JobMode::SWEEP && fromFile.batch.sessions == 500 && fromFile.batch.masterSeed == 4, "config file top-level keys");
+    check(fromFile.config.bankroll == 1500 && fromFile.config.extraBet, "config file [strategy] section");
+    check(fromFile.sweepThresholds == std::vector<int>{ 2, 3 } && fromFile.sweepLossSets.size() == 2 && fromFile.sweepLossSets[1].size() == 2
+        && fromFile.sweepWinSets.size() == 2 && fromFile.sweepWinSets[0].empty(), "config file arrays, nested and over two lines");
+    {
+        std::ofstream f(path);
+        f << "mode = \"batch\"\n\nsessions = [1, 2\n";
+    }
+    try { JobSettings t; readJobFile(path, t); check(false, "unterminated array is refused"); }
+    catch (const std::invalid_argument& e) { check(std::string(e.what()).find(path + ":3:") == 0, std::string("error names the file and line: ") + e.what()); }
+    {
+        std::ofstream f(path);
+        f << "bankroll 1500\n";
+    }
+    checkThrows([&] { JobSettings t; readJobFile(path, t); }, "line without '=' is refused");
+    std::filesystem::remove(path);
+    checkThrows([&] { JobSettings t; readJobFile(path, t); }, "missing config file is refused");
+
+    auto exitCode = [](const std::vector<std::pair<std::string, std::string>>& settings) {
+        std::ostringstream out, err;
+        return runJob({}, settings, out, err);
+    };
+    check(exitCode({ { "mode", "batch" }, { "sessions", "200" }, { "seed", "1" } }) == 0, "a batch job runs");
+    check(exitCode({ { "mode", "batch" } }) == 2, "batch without sessions");
+    check(exitCode({ { "mode", "precision" }, { "precision.max_sessions", "0" } }) == 2, "precision without sessions");
+    check(exitCode({ { "mode", "precision" }, { "checkpoint", tempPath("p.ck") } }) == 2, "checkpoint in a mode that does not save one");
+    check(exitCode({ { "mode", "batch" }, { "sessions", "10" }, { "trace", "50" }, { "trace_file", tempPath("t.csv") } }) == 2, "trace past the last session");
+    check(exitCode({ { "mode", "replay" } }) == 2, "replay without a log");
+    check(exitCode({ { "mode", "batch" }, { "sessions", "200" }, { "initial_bet", "500" }, { "max_bet", "100" } }) == 2, "initial bet above the cap");
+    check(exitCode({ { "mode", "batch" }, { "sessions", "200" }, { "initial_bet", "100" }, { "max_bet", "100" } }) == 0, "initial bet at the cap");
+    check(exitCode({ { "mode", "sweep" }, { "sessions", "200" }, { "sweep.initial_bets", "50 500" }, { "sweep.max_bets", "100 1000" } }) == 2,
+        "sweep grid with a bet above one of its caps");
+    check(exitCode({ { "mode", "sweep" }, { "sessions", "200" }, { "stepping", "scalar" } }) == 2, "stepping in a sweep");
+    check(exitCode({ { "mode", "sweep" }, { "sessions", "200" }, { "accounting", "cents" } }) == 2, "accounting in a sweep");
+    check(exitCode({ { "mode", "batch" }, { "sessions", "200" }, { "sweep.z", "2" } }) == 2, "sweep setting in a batch");
+    check(exitCode({ { "mode", "batch" }, { "sessions", "200" }, { "exact.resolution", "1" } }) == 2, "exact setting in a batch");
+    check(exitCode({ { "mode", "exact" }, { "seed", "3" } }) == 2, "seed in an exact evaluation");
+    check(exitCode({ { "mode", "importance" }, { "sessions", "200" }, { "generator", "philox" } }) == 2, "generator in importance sampling");
+    check(exitCode({ { "mode", "record" }, { "spin_log", tempPath("r.rspl") }, { "log_spins", "10" }, { "bankroll", "500" } }) == 2, "strategy in a recording");
+
+    {
+        std::ostringstream out, err;
+        const int code = runJob({}, { { "mode", "sweep" }, { "sessions", "400" }, { "seed", "2" }, { "generator", "mt19937" }, { "sweep.thresholds", "2 3" } }, out, err);
+        check(code == 0 && out.str().find("\"generator\":\"mt19937\"") != std::string::npos, "a sweep plays the chosen generator");
+        SweepGrid grid;
+        grid.lossThresholds = { 2, 3 };
+        SweepOptions opt;
+        opt.maxSessions = 400; opt.masterSeed = 2; opt.generator = GeneratorKind::MT19937;
+        const SweepResult direct = SweepRunner(opt).run(grid);
+        check(out.str().find("\"ruined\":" + std::to_string(direct.entries[0].ruined) + ",") != std::string::npos, "the sweep job reports the runner's result");
+    }
+    {
+        StrategyConfig config = testConfig(); // a bet that cents must round, so the two accountings part ways
+        config.initialBet = 0.05; config.lossMultipliers = { 1.5 };
+        BatchOptions opt;
+        opt.sessions = 3; opt.masterSeed = 6; opt.accounting = Accounting::CENTS;
+        opt.traceSessions = { 1 }; opt.tracePath = tempPath("cents.csv");
+        SimulationEngine(config).run(opt);
+        std::ifstream trace(opt.tracePath);
+        std::string line, last;
+        while (std::getline(trace, line)) last = line;
+        std::istringstream row(last);
+        std::string bankroll;
+        for (int column = 0; column < 7; ++column) std::getline(row, bankroll, ','); // session, spin, pocket, color, wager, net, bankroll
+        auto replay = [&](auto rules) {
+            BasicRouletteWheel<Xoshiro256x8, AmericanLayout> w(6, 1);
+            return SimulationEngine::playSession(w, rules).finalBankroll;
+        };
+        const double cents = replay(makeStrategyParams<CentMoney>(config)), dollars = replay(makeStrategyParams<DollarMoney>(config));
+        check(cents != dollars && !bankroll.empty() && std::stod(bankroll) == cents, "a cent-accounted trace replays in cents");
+        trace.close();
+        std::filesystem::remove(opt.tracePath);
+    }
+    std::ostringstream out, err;
+    const int code = runJob({}, { { "mode", "batch" }, { "sessions", "300" }, { "seed", "8" } }, out, err);
+    BatchOptions opt;
+    opt.sessions = 300; opt.masterSeed = 8;
+    const BatchResult direct = SimulationEngine(StrategyConfig()).run(opt);
+    check(code == 0 && out.str().find("\"ruined\":" + std::to_string(direct.ruined) + ",") != std::string::npos, "scripted batch reports the engine's result");
+}
+
+// ============================================================================
+//  main
+// ============================================================================
+int main(int argc, char** argv) {
+    const std::pair<const char*, void (*)()> groups[] = {
+        { "lanes", testLanes }, { "crn", testCrn }, { "checkpoint", testCheckpoint }, { "program", testProgram },
+        { "markov", testMarkov }, { "spinlog", testSpinLog }, { "betlayout", testBetLayout }, { "jobs", testJobs },
+    };
+    std::vector<std::string> chosen(argv + 1, argv + argc);
+    for (const std::string& c : chosen)
+        if (std::none_of(std::begin(groups), std::end(groups), [&](const auto& g) { return c == g.first; })) {
+            std::cout << "Unknown test group: " << c << "\nUsage: " << argv[0] << " [group]...   groups:";
+            for (const auto& g : groups) std::cout << ' ' << g.first;
+            std::cout << "\n";
+            return 2;
+        }
+    for (const auto& [name, body] : groups) {
+        if (!chosen.empty() && std::find(chosen.begin(), chosen.end(), name) == chosen.end()) continue;
+        const int before = failures;
+        std::cout << name << "\n";
+        try { body(); }
+        catch (const std::exception& e) { check(false, std::string("unexpected exception: ") + e.what()); }
+        std::cout << "  " << (failures == before ? "ok" : "FAILED") << "\n";
+    }
+    return failures ? 1 : 0;
+}